@@ -67,6 +67,58 @@ public:
     static std::vector<int> TrainingTopology() { return Get().ImplTrainingTopology(); }
     static std::string TrainingDataPath() { return Get().ImplTrainingDataPath(); }
     static int LatestSaveGeneration() { return Get().ImplLatestSaveGeneration(); }
+    // 0 means size the pool from the cpu quota / affinity mask of the process
+    static int TrainingThreadNum() { return Get().ImplTrainingThreadNum(); }
+    // none, compact or scatter
+    static std::string TrainingThreadAffinity() { return Get().ImplTrainingThreadAffinity(); }
+    // evaluate the snakes with the longest expected lifetime first
+    static bool LPTScheduling() { return Get().ImplLPTScheduling(); }
+    // steps a game runs before it goes back to the evaluate queue, 0 runs it to the end
+    static int EvaluationSliceSteps() { return Get().ImplEvaluationSliceSteps(); }
+    // games a thread plays in lockstep with one network per lane, 0 plays them one by one
+    static int InferenceLanes() { return Get().ImplInferenceLanes(); }
+    // end a game at the first repeated state since its last apple, scored as the wander death
+    // it leads to (totalSteps = eatSteps + wanderThreshold + 1). off by default, runs with it
+    // on compare only with runs that had it on
+    static bool LoopDetection() { return Get().ImplLoopDetection(); }
+    // successive halving: stages > 1 plays every game stageSteps steps first, only the best
+    // stageKeep of the unfinished play on with a budget 1 / stageKeep times longer,
+    // the last stage plays to the end. the culled keep the fitness they reached.
+    static int EvaluationStages() { return Get().ImplEvaluationStages(); }
+    static int EvaluationStageSteps() { return Get().ImplEvaluationStageSteps(); }
+    static double EvaluationStageKeep() { return Get().ImplEvaluationStageKeep(); }
+    // no generation barrier: a finished game's child joins the ranked population at once
+    // and the next child is bred and played, a generation is population size evaluations
+    static bool SteadyState() { return Get().ImplSteadyState(); }
+    // games per individual, from seeds every individual of a generation shares
+    // (common random numbers). more than 1 plays whole games, no slices or stages
+    static int EvaluationGames() { return Get().ImplEvaluationGames(); }
+    // how the games' fitness becomes the individual's: mean, min or quantile
+    static std::string EvaluationAggregate() { return Get().ImplEvaluationAggregate(); }
+    static double EvaluationQuantile() { return Get().ImplEvaluationQuantile(); }
+    // all random numbers of a training run from this seed, the run is the same for
+    // any thread count. 0 seeds from the device. steady state depends on the timing
+    static unsigned int MasterSeed() { return Get().ImplMasterSeed(); }
+    // a wall clock budget per generation, 0 for none. the population, a step cap per
+    // game and the wander threshold are adjusted within their bounds to keep to it.
+    // population bounds of 0 are the sample size and PopulationSize, a wander minimum
+    // of 0 keeps the wander threshold. the step cap relaxes up to its maximum (0 for
+    // no bound) and comes off once no game reaches it, or once it is at its maximum
+    // and a generation takes no more than 80% of the budget
+    static int GenerationBudgetMs() { return Get().ImplGenerationBudgetMs(); }
+    static int BudgetPopulationMin() { return Get().ImplBudgetPopulationMin(); }
+    static int BudgetPopulationMax() { return Get().ImplBudgetPopulationMax(); }
+    static int BudgetStepCapMin() { return Get().ImplBudgetStepCapMin(); }
+    static int BudgetStepCapMax() { return Get().ImplBudgetStepCapMax(); }
+    static int BudgetWanderMin() { return Get().ImplBudgetWanderMin(); }
+    // every game plays this seed, 0 draws a new one per game
+    static unsigned int EvaluationSeed() { return Get().ImplEvaluationSeed(); }
+    // with a fixed seed reuse the result of a genome that was evaluated before
+    static bool FitnessCache() { return Get().ImplFitnessCache(); }
+    // carry the samples into the next generation unchanged, next to the children
+    static bool KeepElites() { return Get().ImplKeepElites(); }
+    // every that many generations the culled play on to compare with a full evaluation, 0 never
+    static int EvaluationStageAuditFrequency() { return Get().ImplEvaluationStageAuditFrequency(); }
 
 private:
     // implementation of public methods
@@ -131,12 +183,39 @@ private:
 
     inline std::string ImplTrainingDataPath() { return trainingDataPath; }
     inline int ImplLatestSaveGeneration() { return latestSaveGeneration; }
+    inline int ImplTrainingThreadNum() { return threadNumOverride >= 0 ? threadNumOverride : threadNum; }
+    inline bool ImplLPTScheduling() { return lptScheduling; }
+    inline int ImplEvaluationSliceSteps() { return evaluationSliceSteps; }
+    inline int ImplInferenceLanes() { return inferenceLanes; }
+    inline bool ImplLoopDetection() { return loopDetection; }
+    inline int ImplEvaluationStages() { return evaluationStages; }
+    inline int ImplEvaluationStageSteps() { return evaluationStageSteps; }
+    inline double ImplEvaluationStageKeep() { return evaluationStageKeep; }
+    inline int ImplEvaluationStageAuditFrequency() { return evaluationStageAuditFrequency; }
+    inline unsigned int ImplEvaluationSeed() { return evaluationSeed; }
+    inline unsigned int ImplMasterSeed() { return masterSeed; }
+    inline int ImplGenerationBudgetMs() { return generationBudgetMs; }
+    inline int ImplBudgetPopulationMin() { return budgetPopulationMin; }
+    inline int ImplBudgetPopulationMax() { return budgetPopulationMax; }
+    inline int ImplBudgetStepCapMin() { return budgetStepCapMin; }
+    inline int ImplBudgetStepCapMax() { return budgetStepCapMax; }
+    inline int ImplBudgetWanderMin() { return budgetWanderMin; }
+    inline int ImplEvaluationGames() { return evaluationGames; }
+    inline std::string ImplEvaluationAggregate() { return evaluationAggregate; }
+    inline double ImplEvaluationQuantile() { return evaluationQuantile; }
+    inline bool ImplSteadyState() { return steadyState; }
+    inline bool ImplFitnessCache() { return fitnessCache; }
+    inline bool ImplKeepElites() { return keepElites; }
+    inline std::string ImplTrainingThreadAffinity() { return threadAffinityOverride.empty() ? threadAffinity : threadAffinityOverride; }
 
 public:
     void setAppRunMode(AppRunMode mode) { m_appRunMode = mode; }
     void setNeuralNetworkFilename(const std::string &filename) { nnFilename = std::string(filename); }
     void setLatestSaveGeneration(int gen) { latestSaveGeneration = gen; };
     void setLatestSaveTimestamp(std::string create) { latestSaveTimestamp = create; }
+    // command line overrides, never written back to the config file
+    void setThreadNumOverride(int num) { threadNumOverride = num; }
+    void setThreadAffinityOverride(const std::string &affinity) { threadAffinityOverride = affinity; }
 
     void initAppConfig();
     void saveAppConfig(const std::string &filename = "../config/appConfig.json");
@@ -195,6 +274,32 @@ private:
     std::string trainingDataPath;
     int latestSaveGeneration;
     std::string latestSaveTimestamp;
+    int threadNum;
+    std::string threadAffinity;
+    bool lptScheduling;
+    int evaluationSliceSteps;
+    int inferenceLanes;
+    bool loopDetection;
+    int evaluationStages;
+    int evaluationStageSteps;
+    double evaluationStageKeep;
+    int evaluationStageAuditFrequency;
+    unsigned int evaluationSeed;
+    unsigned int masterSeed;
+    int generationBudgetMs;
+    int budgetPopulationMin;
+    int budgetPopulationMax;
+    int budgetStepCapMin;
+    int budgetStepCapMax;
+    int budgetWanderMin;
+    int evaluationGames;
+    std::string evaluationAggregate;
+    double evaluationQuantile;
+    bool steadyState;
+    bool fitnessCache;
+    bool keepElites;
+    int threadNumOverride = -1;
+    std::string threadAffinityOverride;
 
 private:
     AppConfig();
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <fmt/core.h>
+#include <gflags/gflags.h>
+#include <string>
+
+DECLARE_int32(bench_games);
+DECLARE_int64(bench_seed);
+DECLARE_string(bench_network);
+
+// micro benchmarks and cross checks, run with snake -bench <name>.
+// a bench returns the process exit code, non zero when a check failed.
+namespace bench {
+
+    int run(const std::string &name);
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    inline double elapsedMs(Clock::time_point start) {
+        std::chrono::duration<double, std::milli> d = Clock::now() - start;
+        return d.count();
+    }
+
+    // ms and steps per second of a timed run, one report column
+    inline std::string rate(long long steps, double ms) {
+        return fmt::format("{:10.3f} ms, {:12.0f} steps/s", ms, ms > 0 ? steps * 1000.0 / ms : 0.0);
+    }
+
+    // headless engine against SnakeApp: same games bit for bit, and their speed
+    int engine();
+
+    // the vision builders against the cell by cell walk on several board sizes
+    int vision();
+
+    // nearest body queries and vision on tiled occupancy against the flat plane, from small to large boards
+    int boards();
+
+    // the compiled in board sizes against the same games on DynamicDims
+    int dims();
+
+    // the vector environment with batched inference against playGame one game at a time
+    int vecEnv();
+
+    // lane interleaved networks of a population against feedForward one network at a time
+    int lanes();
+
+    // the body queue of SnakeModel against the ring buffer and the expiry grid, in a
+    // replay and in HeadlessGame
+    int body();
+
+    // how much the ranking of a population depends on the seeds, by games per individual
+    int seeds();
+
+    // one game of a network from its seed, bit for bit the same every time and as SnakeApp plays it.
+    // first the random stream keys of a run and its restore, no key is handed out twice
+    int replay();
+
+    // heap allocations of a training step, none are allowed in the headless loops
+    int alloc();
+
+} // namespace bench
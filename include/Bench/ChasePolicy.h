@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Simulation/HeadlessGame.h"
+#include <cstdint>
+#include <random>
+
+namespace bench {
+
+    // a policy that does not look at the vision, so every pass plays the same games:
+    // head for the apple, take a random turn now and then, avoid walls and body when it can.
+    // one move in turnOdds is a random turn, the fewer the worse it plays
+    template <typename Game>
+    int8_t chase(const Game &game, std::minstd_rand &rng, int turnOdds = 16) {
+        static const int8_t directions[4] = {-1, 1, -2, 2};
+        static const int deltas[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+
+        const sim::GameState &s = game.state();
+        int appleRow = s.apple / game.getCol();
+        int appleCol = s.apple % game.getCol();
+
+        int preferred = appleRow != s.headRow ? (appleRow < s.headRow ? 0 : 1) : (appleCol < s.headCol ? 2 : 3);
+        if (rng() % turnOdds == 0) {
+            preferred = rng() % 4;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            int d = (preferred + i) % 4;
+            int row = s.headRow + deltas[d][0];
+            int col = s.headCol + deltas[d][1];
+            if (row >= 0 && row < game.getRow() && col >= 0 && col < game.getCol() && game.cellAt(row, col) != sim::Cell::snake) {
+                return directions[d];
+            }
+        }
+        return directions[preferred];
+    }
+
+} // namespace bench
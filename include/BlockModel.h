@@ -1,6 +1,6 @@
 #pragma once
 
-#include <vector>
+#include <array>
 
 const char DEFAULT_ICON = '.';
 const char DEFAULT_EMPTY = '.';
@@ -11,7 +11,7 @@ struct BlockPosition {
     int row;
     int col;
 
-    BlockPosition nextPositionOfDirection(const std::vector<int> &change) {
+    BlockPosition nextPositionOfDirection(const std::array<int, 2> &change) const {
         return BlockPosition{row + change[0], col + change[1]};
     }
 };
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "AppRunMode.h"
+#include <memory>
+#include <vector>
+
+// the AppConfig values a game reads while it runs, captured once when the run starts.
+// the models keep a pointer to it, the step loop never goes through AppConfig::Get().
+struct GameSettings {
+    AppRunMode runMode;
+    bool playManually;
+
+    int row;
+    int col;
+    int size;
+
+    // steps without an apple before the snake dies, StrictWander already applied
+    int wanderThreshold;
+
+    // move interval in ms for human / AI mode, already picked for the mode
+    int initInterval;
+    int minInterval;
+    int intervalStep;
+
+    std::vector<int> topology;
+
+    static std::shared_ptr<const GameSettings> capture();
+};
+
+// what the run mode changes in a game, for code specialized on the mode
+template <AppRunMode::Mode mode>
+struct ModeRules {
+    static constexpr bool interactive = mode != AppRunMode::train; /* paced moves, UI, logs */
+    static constexpr bool guardReverse = mode == AppRunMode::human; /* no turning back onto the body */
+};
@@ -20,49 +20,49 @@ public:
     std::string getScoreStr() { return m_scoreStr; }
     void setScoreStr(std::string &scoreStr) {
         m_scoreStr = scoreStr;
-        this->notify(*this, "scoreStr");
+        this->notify(*this, InfoboardEvent::scoreStr);
     }
 
     std::string getStepCountStr() { return m_stepCountStr; }
     void setStepCountStr(std::string &stepCountStr) {
         m_stepCountStr = stepCountStr;
-        this->notify(*this, "stepCountStr");
+        this->notify(*this, InfoboardEvent::stepCountStr);
     }
 
     std::string getRefreshTimeStr() { return m_refreshTimeStr; }
     void setRefreshTimeStr(std::string &refreshTimeStr) {
         m_refreshTimeStr = refreshTimeStr;
-        this->notify(*this, "refreshTimeStr");
+        this->notify(*this, InfoboardEvent::refreshTimeStr);
     }
 
     std::string getDirectionStr() { return m_directionStr; }
     void setDirectionStr(std::string &directionStr) {
         m_directionStr = directionStr;
-        this->notify(*this, "directionStr");
+        this->notify(*this, InfoboardEvent::directionStr);
     }
 
     std::string getGameStateStr() { return m_gameStateStr; }
     void setGameStateStr(std::string &gameState) {
         m_gameStateStr = gameState;
-        this->notify(*this, "gameStateStr");
+        this->notify(*this, InfoboardEvent::gameStateStr);
     }
 
     std::string getGameCommandStr() { return m_gameCommandStr; }
     void setGameCommandStr(const std::string &gameCommand) {
         m_gameCommandStr = gameCommand;
-        this->notify(*this, "gameCommandStr");
+        this->notify(*this, InfoboardEvent::gameCommandStr);
     }
 
     void setFPSStr(const std::string &fpsStr) {
         m_FPSStr = fpsStr;
-        this->notify(*this, "fpsStr");
+        this->notify(*this, InfoboardEvent::fpsStr);
     }
 
     std::string getFPSStr() { return m_FPSStr; }
 
     void setInfoStr(const std::string &info) {
         m_infoStr = info;
-        this->notify(*this, "infoStr");
+        this->notify(*this, InfoboardEvent::infoStr);
     }
     std::string getInfoStr() { return m_infoStr; }
 
@@ -75,8 +75,8 @@ public:
     std::string getLeftValueStr() { return m_leftStr; }
     std::string getRightValueStr() { return m_rightStr; }
 
-    void field_changed(SnakeModel &source, const string &field_name);
-    void field_changed(SnakeApp &source, const string &field_name);
+    void field_changed(SnakeModel &source, SnakeEvent::Type event);
+    void field_changed(SnakeApp &source, AppEvent::Type event);
 
 private:
 
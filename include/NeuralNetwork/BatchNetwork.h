@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "Activate.h"
+
+class NeuralNetwork;
+
+// a snapshot of a NeuralNetwork for running many inputs through it at once.
+// the weights are copied into flat arrays and a layer is computed for the whole
+// batch, the inner loop runs over the batch so it vectorizes.
+// every sample gets the same values as NeuralNetwork::feedForward, bit for bit:
+// the sums are taken in the same order and the bias and activation added the same way.
+class BatchNetwork {
+public:
+    explicit BatchNetwork(NeuralNetwork &nn);
+
+    // input: batch x inputSize, output: batch x outputSize, sample major
+    void forward(const double *input, int batch, double *output);
+
+    int inputSize() const { return m_inputSize; }
+    int outputSize() const { return m_outputSize; }
+
+private:
+    struct LayerWeights {
+        int in;
+        int out;
+        std::vector<double> weights; /* [k * out + j], from neuron k to neuron j */
+        NN::ActivationType type;
+        ActivateFunction activate;
+    };
+
+    int m_inputSize;
+    int m_outputSize;
+    double m_bias;
+    std::vector<LayerWeights> m_layers;
+
+    // activations of the batch, neuron major: [neuron * batch + sample]
+    std::vector<double> m_values;
+    std::vector<double> m_next;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "Activate.h"
+
+class NeuralNetwork;
+
+// K networks of one topology evaluated together, one per lane.
+// weight (k, j) of lanes 0..K-1 sit next to each other, so the inner loop computes
+// the same neuron of every lane on that lane's own input and vectorizes across lanes.
+// a lane gets the values NeuralNetwork::feedForward gives for its network, bit for bit.
+class LaneNetwork {
+public:
+    LaneNetwork(const std::vector<int> &topology, int laneNum);
+
+    // copy the weights of nn into lane, the activations are taken from nn
+    void setLane(int lane, NeuralNetwork &nn);
+    // the same from a flat genome, see ga::copyFromNetwork
+    void setLane(int lane, const double *genome);
+    // the bias and layer activations every lane runs with
+    void setActivations(NeuralNetwork &nn);
+
+    // input: laneNum x inputSize, output: laneNum x outputSize, lane major
+    void forward(const double *input, double *output);
+
+    int laneNum() const { return m_laneNum; }
+    int inputSize() const { return m_topology.front(); }
+    int outputSize() const { return m_topology.back(); }
+
+private:
+    struct LayerWeights {
+        int in;
+        int out;
+        std::vector<double> weights; /* [(k * out + j) * laneNum + lane] */
+        NN::ActivationType type;
+        ActivateFunction activate;
+    };
+
+    std::vector<int> m_topology;
+    int m_laneNum;
+    double m_bias;
+    std::vector<LayerWeights> m_layers;
+
+    // activations, neuron major: [neuron * laneNum + lane]
+    std::vector<double> m_values;
+    std::vector<double> m_next;
+};
@@ -17,6 +17,10 @@ public:
 
     void setValAt(int index, double val);
     double getValAt(int index);
+    double getActivatedValAt(int index) { return m_neurons[index]->getActivatedVal(); }
+    // getValAt or getActivatedValAt of every neuron, setValAt of every neuron
+    void getVals(double *vals, bool activated);
+    void setVals(const double *vals);
 
     std::shared_ptr<Matrix> valMatrix();
     std::shared_ptr<Matrix> activatedValMatrix();
@@ -24,6 +28,7 @@ public:
 
     std::shared_ptr<std::vector<double>> activatedValVector();
     void setActivateType(NN::ActivationType type);
+    NN::ActivationType getActivateType() { return m_activateType; }
 
 private:
     std::shared_ptr<Matrix> buildMatrix(const std::function<double(int, int)> &valueAt);
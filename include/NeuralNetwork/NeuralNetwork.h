@@ -18,12 +18,15 @@ public:
     ~NeuralNetwork();
 
     void setInput(const std::vector<double> &input);
+    void setInput(const double *input, int size);
     void feedForward();
 
 public:
     void setWeightMatricesWithRandomValue();
     void setNeuronValue(int indexLayer, int indexNeuron, double val) { this->m_layers.at(indexLayer)->setValAt(indexNeuron, val); }
     void setLayerActivateType(int indexLayer, const NN::ActivationType &type) { this->m_layers.at(indexLayer)->setActivateType(type); }
+    NN::ActivationType layerActivateTypeAt(int indexLayer) { return this->m_layers.at(indexLayer)->getActivateType(); }
+    double getBias() { return m_bias; }
 
     const std::vector<int> &getTopology() { return m_topology; }
 
@@ -32,6 +35,8 @@ public:
 
 public:
     std::shared_ptr<std::vector<double>> activatedValVectorOfLayerAt(int index) { return this->m_layers.at(index)->activatedValVector(); }
+    // the same into values, without allocating
+    void activatedValuesOfLayerAt(int index, double *values);
 
     std::shared_ptr<Matrix> valMatrixOfLayerAt(int index) { return this->m_layers.at(index)->valMatrix(); }
     std::shared_ptr<Matrix> activatedValMatrixOfLayerAt(int index) { return this->m_layers.at(index)->activatedValMatrix(); }
@@ -48,7 +53,6 @@ private:
     void initWeightMatrices(bool initWithRandom = false);
 
 private:
-    std::vector<double> m_input;
     double m_bias = 1.0;
 
     json m_description;
@@ -57,4 +61,8 @@ private:
     std::vector<int> m_topology;
     std::vector<std::shared_ptr<Layer>> m_layers;
     std::vector<std::shared_ptr<Matrix>> m_weightMatrices;
+
+    // feedForward scratch: the layer to the left, the sums of the layer to the right
+    std::vector<double> m_in;
+    std::vector<double> m_sum;
 };
@@ -18,6 +18,12 @@ public:
         }
     }
 
+    // setVal with the activated value already known
+    void setActivated(double v, double activated) {
+        this->val = v;
+        this->activatedVal = activated;
+    }
+
     double getVal() { return val; }
     double getActivatedVal() { return activatedVal; }
     double getDerivedVal() { return derivedVal; }
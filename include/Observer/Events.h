@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+
+class SnakeModel;
+class PlayboardModel;
+class InfoboardModel;
+class UIManager;
+class SnakeApp;
+
+// the events each observable sends, count is the number of events
+
+struct SnakeEvent {
+    enum Type : uint8_t {
+        direction,
+        nextDirection,
+        state,
+        score,
+        stepCount,
+        refreshTime,
+        playStep,
+        move,
+        addHeadBlock,
+        removeTailBlock,
+        eat,
+        forward,
+        count
+    };
+};
+
+struct PlayboardEvent {
+    enum Type : uint8_t {
+        placeApple,
+        eraseApple,
+        count
+    };
+};
+
+struct InfoboardEvent {
+    enum Type : uint8_t {
+        scoreStr,
+        stepCountStr,
+        refreshTimeStr,
+        directionStr,
+        gameStateStr,
+        gameCommandStr,
+        fpsStr,
+        infoStr,
+        nextDirectionStr,
+        count
+    };
+};
+
+struct UIEvent {
+    enum Type : uint8_t {
+        quit,
+        down,
+        up,
+        right,
+        left,
+        onPKeyPressed,
+        onQKeyPressed,
+        onRKeyPressed,
+        onSpacePressed,
+        count
+    };
+};
+
+struct AppEvent {
+    enum Type : uint8_t {
+        state,
+        count
+    };
+};
+
+// the event enum of an observable type
+template <typename T>
+struct EventOf;
+
+template <>
+struct EventOf<SnakeModel> { using Type = SnakeEvent::Type; };
+template <>
+struct EventOf<PlayboardModel> { using Type = PlayboardEvent::Type; };
+template <>
+struct EventOf<InfoboardModel> { using Type = InfoboardEvent::Type; };
+template <>
+struct EventOf<UIManager> { using Type = UIEvent::Type; };
+template <>
+struct EventOf<SnakeApp> { using Type = AppEvent::Type; };
+
+template <typename T>
+using Event = typename EventOf<T>::Type;
@@ -1,4 +1,8 @@
 #pragma once
+#include "Observer/Events.h"
+#include <algorithm>
+#include <array>
+#include <initializer_list>
 #include <memory>
 #include <string>
 #include <vector>
@@ -8,22 +12,35 @@ using namespace std;
 template <typename T>
 class Observer {
 public:
-    virtual void field_changed(T &source, const string &field_name) = 0;
+    virtual void field_changed(T &source, Event<T> event) = 0;
     virtual ~Observer() = default;
 };
 
+// one observer list per event: a notify calls only the observers of that event,
+// an event nobody listens to is an empty loop.
 template <typename T>
 class Observable {
 public:
-    void notify(T &source, const string &field_name) {
-        for (auto observer : m_observers)
-            observer->field_changed(source, field_name);
+    void notify(T &source, Event<T> event) {
+        for (auto observer : m_observers[event])
+            observer->field_changed(source, event);
+    }
+
+    // every event
+    void addObserver(Observer<T> &observer) {
+        for (auto &observers : m_observers)
+            observers.push_back(&observer);
+    }
+    // only the listed events
+    void addObserver(Observer<T> &observer, std::initializer_list<Event<T>> events) {
+        for (auto event : events)
+            m_observers[event].push_back(&observer);
     }
-    void addObserver(Observer<T> &observer) { m_observers.push_back(&observer); }
     void removeObserver(Observer<T> &observer) {
-        m_observers.erase(remove(m_observers.begin(), m_observers.end(), &observer), m_observers.end());
+        for (auto &observers : m_observers)
+            observers.erase(remove(observers.begin(), observers.end(), &observer), observers.end());
     }
 
 private:
-    vector<Observer<T> *> m_observers;
+    array<vector<Observer<T> *>, Event<T>::count> m_observers;
 };
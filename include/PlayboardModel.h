@@ -1,7 +1,9 @@
 #pragma once
 
 #include "BlockModel.h"
+#include "GameSettings.h"
 #include "Observer/Observer.h"
+#include "Simulation/FreeCellSet.h"
 #include "Utility.h"
 
 class SnakeModel;
@@ -12,8 +14,7 @@ class PlayboardModel : public Observable<PlayboardModel>,
 
     friend SnakeBrain;
 public:
-    PlayboardModel();
-    PlayboardModel(int row, int col);
+    explicit PlayboardModel(std::shared_ptr<const GameSettings> settings);
     ~PlayboardModel();
 
     void initPlayboard();
@@ -34,18 +35,26 @@ public:
 
 private:
     // Observer
-    void field_changed(SnakeModel &source, const string &field_name);
+    void field_changed(SnakeModel &source, SnakeEvent::Type event);
 
 private:
     void eraseApple();
 
     void addBlock(BlockBase drawable) { addBlockImpl(drawable.getRow(), drawable.getCol(), drawable.getIcon()); }
-    void addBlockImpl(int y, int x, char ch) { m_board[y][x] = ch; }
+    void addBlockImpl(int y, int x, char ch) {
+        m_board[y][x] = ch;
+        if (ch == DEFAULT_EMPTY) {
+            m_freeCells.insert(y * m_col + x);
+        } else {
+            m_freeCells.erase(y * m_col + x);
+        }
+    }
 
+    // one draw over the free cells, however long the snake is
     void getRandomEmptyPosition(int &row, int &col) {
-        while (row = utility::random::generateRandomNumber(0, m_row - 1),
-               col = utility::random::generateRandomNumber(0, m_col - 1), !isEmpty(row, col))
-            ;
+        int cell = m_freeCells.at(utility::random::generateRandomNumber(0, m_freeCells.size() - 1));
+        row = cell / m_col;
+        col = cell % m_col;
     }
 
     bool isWithinBound(BlockPosition pos) {
@@ -60,10 +69,13 @@ private:
     }
 
 private:
+    std::shared_ptr<const GameSettings> m_settings;
+
     int m_row;
     int m_col;
 
     char **m_board;
+    sim::FreeCellSet m_freeCells; /* cells that are DEFAULT_EMPTY on m_board */
 
     BlockPosition m_applePosition;
 };
\ No newline at end of file
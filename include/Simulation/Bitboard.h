@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Simulation/BoardDims.h"
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // one bit per playboard cell, row major, cell i is bit i % 64 of word i / 64.
+    // a 10x10 board fits in two words. Words is a std::array for a fixed board size.
+    template <typename Words>
+    class BasicBitboard {
+    public:
+        BasicBitboard() = default;
+        explicit BasicBitboard(int bitNum) {
+            resizeArray(m_words, (bitNum + 63) / 64);
+            clear();
+        }
+
+        void set(int i) { m_words[i >> 6] |= uint64_t(1) << (i & 63); }
+        void reset(int i) { m_words[i >> 6] &= ~(uint64_t(1) << (i & 63)); }
+        bool test(int i) const { return (m_words[i >> 6] >> (i & 63)) & 1; }
+
+        void clear() {
+            for (auto &w : m_words) {
+                w = 0;
+            }
+        }
+
+        int wordNum() const { return m_words.size(); }
+        uint64_t word(int w) const { return m_words[w]; }
+        const uint64_t *data() const { return m_words.data(); }
+
+    private:
+        Words m_words;
+    };
+
+    using Bitboard = BasicBitboard<std::vector<uint64_t>>;
+
+    // a plane stored elsewhere, read only
+    class BitboardView {
+    public:
+        explicit BitboardView(const uint64_t *words) : m_words(words) {}
+
+        bool test(int i) const { return (m_words[i >> 6] >> (i & 63)) & 1; }
+        uint64_t word(int w) const { return m_words[w]; }
+
+    private:
+        const uint64_t *m_words;
+    };
+
+    // index of the lowest / highest set bit, word must not be 0
+    inline int lowestBit(uint64_t word) { return __builtin_ctzll(word); }
+    inline int highestBit(uint64_t word) { return 63 - __builtin_clzll(word); }
+
+} // namespace sim
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // board dimensions of a headless game and the storage that goes with them.
+    // FixedDims makes the size a constant: bounds checks and cell indexing
+    // compile to immediates, and the board arrays live inline in the game.
+    template <int R, int C>
+    struct FixedDims {
+        static constexpr bool c_fixed = true;
+
+        constexpr int row() const { return R; }
+        constexpr int col() const { return C; }
+        constexpr int size() const { return R * C; }
+
+        template <typename T>
+        using CellArray = std::array<T, R * C>;
+        template <typename T>
+        using LineArray = std::array<T, (R > C ? R : C) + 1>; /* by distance + 1 */
+        using WordArray = std::array<uint64_t, (R * C + 63) / 64>;
+        using Index = int16_t;
+    };
+
+    // any board size, storage on the heap
+    struct DynamicDims {
+        static constexpr bool c_fixed = false;
+
+        DynamicDims(int row, int col) : m_row(row), m_col(col) {}
+
+        int row() const { return m_row; }
+        int col() const { return m_col; }
+        int size() const { return m_row * m_col; }
+
+        template <typename T>
+        using CellArray = std::vector<T>;
+        template <typename T>
+        using LineArray = std::vector<T>;
+        using WordArray = std::vector<uint64_t>;
+        using Index = int32_t;
+
+    private:
+        int m_row;
+        int m_col;
+    };
+
+    // a std::array already has its size, a vector is resized
+    template <typename T, size_t N>
+    void resizeArray(std::array<T, N> &, size_t) {}
+
+    template <typename T>
+    void resizeArray(std::vector<T> &v, size_t n) { v.resize(n); }
+
+} // namespace sim
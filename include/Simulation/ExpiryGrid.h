@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // snake body as the time each cell becomes free.
+    // the clock counts tail moves, a segment i cells behind the head of a snake
+    // of length L leaves after L - i more of them. so a cell is occupied iff its
+    // expiry is past the clock, a move only writes the head cell, and eating
+    // leaves the clock alone, which keeps every segment one move longer.
+    // the grid alone does not know where the tail is, the tail cell is kept on
+    // the side: the next one is the neighbour of the old tail that expires first.
+    class ExpiryGrid {
+    public:
+        ExpiryGrid() = default;
+        ExpiryGrid(int row, int col) : m_row(row), m_col(col), m_expiry(row * col, 0) {}
+
+        // no snake. the clock jumps past every old expiry instead of clearing the grid.
+        void clear() {
+            if (m_clock > c_clockLimit) {
+                std::fill(m_expiry.begin(), m_expiry.end(), 0);
+                m_clock = 0;
+            }
+            m_clock += m_length + 1;
+            m_length = 0;
+            m_tail = -1;
+        }
+
+        // a length 1 snake at headCell, everything else free
+        void reset(int headCell) {
+            clear();
+            grow(headCell);
+        }
+
+        bool occupied(int cell) const { return m_expiry[cell] > m_clock; }
+
+        // tail moves until the cell is free, 0 when it is free now.
+        // a snake that keeps moving without eating can enter it after that many steps.
+        int freeIn(int cell) const { return std::max(0, m_expiry[cell] - m_clock); }
+        bool freeBy(int cell, int steps) const { return m_expiry[cell] <= m_clock + steps; }
+
+        // the head moves to headCell, the tail leaves: the freed cell
+        int forward(int headCell) {
+            const int freed = popTail();
+            grow(headCell);
+            return freed;
+        }
+
+        // the head moves to headCell and the tail stays
+        void grow(int headCell) {
+            if (m_length == 0) {
+                m_tail = headCell;
+            }
+            m_length++;
+            m_expiry[headCell] = m_clock + m_length;
+        }
+
+        // the tail leaves without a new head, the freed cell
+        int popTail() {
+            const int freed = m_tail;
+            m_clock++;
+            m_length--;
+            m_tail = m_length > 0 ? nextTail(freed) : -1;
+            return freed;
+        }
+
+        int tail() const { return m_tail; }
+        int length() const { return m_length; }
+        int cellNum() const { return int(m_expiry.size()); }
+
+    private:
+        // the segment after the one that just left: next to it and the first to expire
+        int nextTail(int freed) const {
+            const int row = freed / m_col, col = freed % m_col;
+            const int due = m_clock + 1;
+            if (row > 0 && m_expiry[freed - m_col] == due) {
+                return freed - m_col;
+            }
+            if (row + 1 < m_row && m_expiry[freed + m_col] == due) {
+                return freed + m_col;
+            }
+            if (col > 0 && m_expiry[freed - 1] == due) {
+                return freed - 1;
+            }
+            return freed + 1;
+        }
+
+    private:
+        static constexpr int32_t c_clockLimit = 1 << 30;
+
+        int m_row = 0;
+        int m_col = 0;
+        std::vector<int32_t> m_expiry;
+        int32_t m_clock = 0;
+        int32_t m_length = 0;
+        int m_tail = -1;
+    };
+
+} // namespace sim
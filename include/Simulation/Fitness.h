@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace sim {
+
+    // GA rank of a finished game, SnakeModel and the headless engine share it
+    long double fitness(int score, int totalSteps);
+
+    // how the fitness of several games of one individual becomes its fitness
+    enum class FitnessAggregate {
+        mean,
+        min,
+        quantile,
+    };
+
+    // "mean", "min" or "quantile", anything else is mean
+    FitnessAggregate fitnessAggregateOf(const std::string &name);
+    const char *nameOf(FitnessAggregate aggregate);
+
+    // values of n games, reordered. quantile q of them ascending, 0 is the min, 0.5 the median
+    long double aggregateFitness(long double *values, int n, FitnessAggregate aggregate, double quantile);
+
+} // namespace sim
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Simulation/BoardDims.h"
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // the free cells of a playboard as a dense array plus the slot of every cell,
+    // insert and erase are O(1) by swap remove, and the n-th free cell is one lookup.
+    // the array order depends on the order of the updates, two boards fed the same
+    // updates pick the same cell for the same n.
+    // Slots is a std::array for a fixed board size.
+    template <typename Slots>
+    class BasicFreeCellSet {
+    public:
+        BasicFreeCellSet() = default;
+        explicit BasicFreeCellSet(int cellNum) : m_cellNum(cellNum) {
+            resizeArray(m_cells, cellNum);
+            resizeArray(m_slot, cellNum);
+            fill();
+        }
+
+        // every cell free, in cell order
+        void fill() {
+            for (int cell = 0; cell < m_cellNum; cell++) {
+                m_cells[cell] = cell;
+                m_slot[cell] = cell;
+            }
+            m_count = m_cellNum;
+        }
+
+        bool contains(int cell) const { return m_slot[cell] != c_none; }
+
+        void insert(int cell) {
+            if (contains(cell)) {
+                return;
+            }
+            m_slot[cell] = m_count;
+            m_cells[m_count++] = cell;
+        }
+
+        void erase(int cell) {
+            if (!contains(cell)) {
+                return;
+            }
+            const int slot = m_slot[cell];
+            const int last = m_cells[--m_count];
+            m_cells[slot] = last;
+            m_slot[last] = slot;
+            m_slot[cell] = c_none;
+        }
+
+        int size() const { return m_count; }
+        int at(int n) const { return m_cells[n]; }
+
+    private:
+        static constexpr int c_none = -1;
+
+        int m_cellNum = 0;
+        int m_count = 0;
+        Slots m_cells;
+        Slots m_slot; /* index in m_cells, c_none when not free */
+    };
+
+    using FreeCellSet = BasicFreeCellSet<std::vector<int32_t>>;
+
+} // namespace sim
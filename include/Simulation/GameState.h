@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+namespace sim {
+
+    enum Cell : uint8_t {
+        empty = 0,
+        snake = 1,
+        apple = 2
+    };
+
+    // what the last step did, the death reasons end the game
+    enum StepResult : uint8_t {
+        moved = 0,
+        ate = 1,
+        hitWall = 2,
+        biteSelf = 3,
+        wandered = 4,
+        perfect = 5,
+        looped = 6 /* a repeat of a state since the last apple, scored as the wander death it leads to */
+    };
+
+    // a running game besides its board, plain data
+    struct GameState {
+        int32_t score;
+        int32_t totalSteps;
+        int32_t eatSteps; /* totalSteps when the last apple was eaten */
+        int32_t headRow;
+        int32_t headCol;
+        int32_t apple;    /* cell index, -1 when there is none */
+        int32_t length;
+        int8_t direction; /* SnakeDirection raw value */
+        bool alive;
+        StepResult last;
+    };
+
+    static_assert(std::is_trivially_copyable_v<GameState>);
+    static_assert(std::is_standard_layout_v<GameState>);
+
+} // namespace sim
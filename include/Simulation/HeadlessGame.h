@@ -0,0 +1,237 @@
+#pragma once
+
+#include "Simulation/Bitboard.h"
+#include "Simulation/BoardDims.h"
+#include "Simulation/ExpiryGrid.h"
+#include "Simulation/FreeCellSet.h"
+#include "Simulation/GameState.h"
+#include "Simulation/LoopDetector.h"
+#include "Simulation/RayTable.h"
+#include "Simulation/TiledOccupancy.h"
+#include "Simulation/Vision.h"
+#include <memory>
+#include <optional>
+#include <random>
+#include <variant>
+#include <vector>
+
+class SnakeBrain;
+
+namespace sim {
+
+    // the training game without SnakeApp, models and observers.
+    // it follows the train mode rules of SnakeModel / PlayboardModel step for step,
+    // random numbers included, a game played here and one played by SnakeApp
+    // from the same seed are the same game.
+    // Dims is FixedDims for the board sizes compiled in, DynamicDims for any other.
+    template <typename Dims>
+    class BasicHeadlessGame {
+    public:
+        static constexpr int c_visionSize = sim::c_visionSize;
+        static constexpr int c_directionSize = 4;
+        static constexpr int c_inputSize = c_visionSize + c_directionSize;
+
+        BasicHeadlessGame(Dims dims, int wanderThreshold);
+
+        void reset(unsigned int seed); /* SnakeModel::initSnake then PlayboardModel::initPlayboard */
+        StepResult step();             /* one move in the current direction */
+        void setDirection(int8_t direction) { m_state.direction = direction; }
+
+        // end a game at the first repeated state since the last apple, as looped, with the
+        // steps the wander limit would have ended it at. only sound for a deterministic
+        // brain, off by default, takes effect from the next reset.
+        void setLoopDetection(bool on);
+
+        // the body as an ExpiryGrid instead of the ring buffer, the same game.
+        // off by default, takes effect from the next reset.
+        void setExpiryBody(bool on) { m_expiryBodyNext = on; }
+        bool isExpiryBody() const { return m_expiryBody; }
+        // tail moves until the body leaves the cell, 0 when it is free. expiry body only
+        int freeIn(int row, int col) const { return m_expiry.freeIn(row * m_dims.col() + col); }
+
+        // nearest body queries on a TiledOccupancy instead of the flat plane rays,
+        // on by default for boards larger than c_tiledBoardSize
+        static constexpr int c_tiledBoardSize = 64;
+        void setTiledOccupancy(bool on);
+        bool isTiledOccupancy() const { return m_tiled; }
+
+        // same layout and values as SnakeBrain::buildVisionVector,
+        // by bit scans of the body plane, or of the tiles while they are on
+        void buildVision(double *vision) const;
+        // the same by walking the rays cell by cell like SnakeBrain, the reference
+        void buildVisionByWalk(double *vision) const;
+        // vision followed by the one hot direction, the network input
+        void buildInput(double *input) const;
+
+        const GameState &state() const { return m_state; }
+        bool isAlive() const { return m_state.alive; }
+        int getRow() const { return m_dims.row(); }
+        int getCol() const { return m_dims.col(); }
+        Cell cellAt(int row, int col) const { return Cell(m_cells[row * m_dims.col() + col]); }
+
+    private:
+        using Index = typename Dims::Index;
+
+        int randomNumber(int low, int high);
+
+        void addHead(int row, int col);
+        int removeTail(); /* the freed cell */
+        void placeApple();
+        void die(StepResult reason);
+
+    private:
+        Dims m_dims;
+        int m_wanderThreshold;
+
+        GameState m_state;
+        typename Dims::template CellArray<uint8_t> m_cells; /* Cell, row major */
+        typename Dims::template CellArray<Index> m_body;    /* ring buffer of cell indices, head at m_bodyHead */
+        int m_bodyHead;
+        // or the body by expiry, built the first time it is on
+        bool m_expiryBody;
+        bool m_expiryBodyNext;
+        ExpiryGrid m_expiry;
+        BasicFreeCellSet<typename Dims::template CellArray<Index>> m_freeCells; /* empty cells, updated in the same order as PlayboardModel */
+
+        // vision: the body plane is kept in step with m_cells.
+        // the apple is a single cell, its ray follows from the two positions.
+        const RayTable *m_rays;
+        BasicBitboard<typename Dims::WordArray> m_bodyPlane;
+        // large boards: the body plane again in tiles, built the first time
+        // m_tiled is on and kept only while it is
+        bool m_tiled;
+        std::optional<TiledOccupancy> m_bodyTiles;
+
+        // vision values by distance + 1 (-1 is nothing in sight)
+        typename Dims::template LineArray<double> m_wallValue;
+        typename Dims::template LineArray<double> m_bodyValue;
+        typename Dims::template LineArray<double> m_foodValue;
+
+        LoopDetector m_loops;
+
+        std::minstd_rand m_rng;
+    };
+
+    // a game on the heap. a variant is as large as its largest alternative, the
+    // 32x32 game is about 8 KB inline, the 10x10 one 1.2 KB: the larger boards are
+    // boxed so a game of the default board does not carry them. copies are deep,
+    // a copy into a box of the same size reuses its storage, a copy of a
+    // moved-from box is empty like it.
+    template <typename Game>
+    class Boxed {
+    public:
+        explicit Boxed(Game game) : m_game(std::make_unique<Game>(std::move(game))) {}
+        Boxed(const Boxed &other) : m_game(other.m_game ? std::make_unique<Game>(*other.m_game) : nullptr) {}
+        Boxed(Boxed &&) noexcept = default;
+        Boxed &operator=(const Boxed &other) {
+            if (!other.m_game) {
+                m_game.reset();
+            } else if (!m_game) {
+                m_game = std::make_unique<Game>(*other.m_game);
+            } else if (this != &other) {
+                *m_game = *other.m_game;
+            }
+            return *this;
+        }
+        Boxed &operator=(Boxed &&) noexcept = default;
+
+        Game &get() { return *m_game; }
+        const Game &get() const { return *m_game; }
+
+    private:
+        std::unique_ptr<Game> m_game;
+    };
+
+    // the game of a GameVariant alternative, boxed or not
+    template <typename Game>
+    Game &unbox(Game &game) { return game; }
+    template <typename Game>
+    const Game &unbox(const Game &game) { return game; }
+    template <typename Game>
+    Game &unbox(Boxed<Game> &game) { return game.get(); }
+    template <typename Game>
+    const Game &unbox(const Boxed<Game> &game) { return game.get(); }
+
+    // the board sizes with a compiled in game, any other size runs on DynamicDims
+    using GameVariant = std::variant<BasicHeadlessGame<FixedDims<10, 10>>,
+                                     Boxed<BasicHeadlessGame<FixedDims<16, 16>>>,
+                                     Boxed<BasicHeadlessGame<FixedDims<20, 20>>>,
+                                     Boxed<BasicHeadlessGame<FixedDims<32, 32>>>,
+                                     BasicHeadlessGame<DynamicDims>>;
+
+    // a headless game of the board size picked at run time
+    class HeadlessGame {
+    public:
+        static constexpr int c_visionSize = sim::c_visionSize;
+        static constexpr int c_directionSize = 4;
+        static constexpr int c_inputSize = c_visionSize + c_directionSize;
+
+        // allowFixed = false always uses DynamicDims, to compare the two
+        HeadlessGame(int row, int col, int wanderThreshold, bool allowFixed = true);
+
+        void reset(unsigned int seed) {
+            std::visit([=](auto &g) { unbox(g).reset(seed); }, m_game);
+        }
+        StepResult step() {
+            return std::visit([](auto &g) { return unbox(g).step(); }, m_game);
+        }
+        void setDirection(int8_t direction) {
+            std::visit([=](auto &g) { unbox(g).setDirection(direction); }, m_game);
+        }
+        void setLoopDetection(bool on) {
+            std::visit([=](auto &g) { unbox(g).setLoopDetection(on); }, m_game);
+        }
+        void setExpiryBody(bool on) {
+            std::visit([=](auto &g) { unbox(g).setExpiryBody(on); }, m_game);
+        }
+        bool isExpiryBody() const {
+            return std::visit([](const auto &g) { return unbox(g).isExpiryBody(); }, m_game);
+        }
+        int freeIn(int row, int col) const {
+            return std::visit([=](const auto &g) { return unbox(g).freeIn(row, col); }, m_game);
+        }
+        void setTiledOccupancy(bool on) {
+            std::visit([=](auto &g) { unbox(g).setTiledOccupancy(on); }, m_game);
+        }
+        bool isTiledOccupancy() const {
+            return std::visit([](const auto &g) { return unbox(g).isTiledOccupancy(); }, m_game);
+        }
+
+        void buildVision(double *vision) const {
+            std::visit([=](const auto &g) { unbox(g).buildVision(vision); }, m_game);
+        }
+        void buildVisionByWalk(double *vision) const {
+            std::visit([=](const auto &g) { unbox(g).buildVisionByWalk(vision); }, m_game);
+        }
+        void buildInput(double *input) const {
+            std::visit([=](const auto &g) { unbox(g).buildInput(input); }, m_game);
+        }
+
+        const GameState &state() const {
+            return std::visit([](const auto &g) -> const GameState & { return unbox(g).state(); }, m_game);
+        }
+        bool isAlive() const { return state().alive; }
+        int getRow() const { return m_row; }
+        int getCol() const { return m_col; }
+        Cell cellAt(int row, int col) const {
+            return std::visit([=](const auto &g) { return unbox(g).cellAt(row, col); }, m_game);
+        }
+
+        // true when the board size has a compiled in game
+        bool isFixed() const { return m_game.index() + 1 != std::variant_size_v<GameVariant>; }
+
+        // to run a whole loop on the typed game, one dispatch instead of one per call,
+        // unbox() the alternative for the game
+        GameVariant &variant() { return m_game; }
+
+    private:
+        int m_row;
+        int m_col;
+        GameVariant m_game;
+    };
+
+    // let the brain drive the game the way SnakeModel::update does in train mode,
+    // at most maxSteps steps (<= 0 for no limit). returns true once the game ended.
+    bool playGame(HeadlessGame &game, SnakeBrain &brain, int maxSteps);
+
+} // namespace sim
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "NeuralNetwork/LaneNetwork.h"
+#include "Simulation/VecEnv.h"
+#include <functional>
+#include <vector>
+
+class NeuralNetwork;
+
+namespace sim {
+
+    // plays one game per network, laneNum games in lockstep: a VecEnv lane and a
+    // LaneNetwork lane per game, one interleaved forward pass thinks for all of them.
+    // a lane whose game ended takes the next job right away, so the lanes stay full
+    // until the jobs run out. every game is the one playGame plays from the same seed.
+    class LaneEvaluator {
+    public:
+        struct Job {
+            int index;            /* handed back with the result */
+            const double *genome; /* the weights, ga::copyFromNetwork layout */
+            unsigned int seed;
+        };
+
+        // fill job and return true, false when there is no job left
+        using NextJob = std::function<bool(Job &job)>;
+        using Finished = std::function<void(int index, const EpisodeResult &result)>;
+
+        // every lane runs with the topology and activations of prototype
+        LaneEvaluator(int laneNum, int row, int col, int wanderThreshold, NeuralNetwork &prototype);
+
+        // until next() runs dry and the last game ended, returns the steps played
+        long long run(const NextJob &next, const Finished &finished);
+
+        int laneNum() const { return m_env.size(); }
+        void setLoopDetection(bool on) { m_env.setLoopDetection(on); }
+
+    private:
+        void startLane(int lane, const NextJob &next, const Finished &finished);
+
+    private:
+        VecEnv m_env;
+        LaneNetwork m_network;
+        std::vector<int> m_index; /* job index of every lane, -1 idle */
+
+        std::vector<double> m_inputs;
+        std::vector<double> m_outputs;
+        std::vector<int8_t> m_directions;
+    };
+
+} // namespace sim
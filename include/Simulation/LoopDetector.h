@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // finds a game that went round in circles since its last apple.
+    // between two apples the brain only sees the body, the apple and the
+    // direction, and the apple does not move. a deterministic brain that
+    // meets the same body and direction again repeats itself until the
+    // wander limit ends the game, so the game can end at the first repeat.
+    //
+    // the body is kept as a rolling hash of its cells from head to tail,
+    // a random 64 bit key per cell: a move adds the head and drops the tail in
+    // O(1), eating only adds the head. the states seen since the last apple
+    // are an open addressing set stamped with the apple count, so starting
+    // over does not clear it. a repeat is a 64 bit hash match, not compared
+    // cell by cell.
+    class LoopDetector {
+    public:
+        LoopDetector() = default;
+
+        // statesPerApple: the most states a game can see between two apples,
+        // the wander threshold + 1
+        explicit LoopDetector(int statesPerApple) {
+            int capacity = 16;
+            while (capacity < 2 * statesPerApple) {
+                capacity <<= 1;
+            }
+            m_keys.assign(capacity, 0);
+            m_stamps.assign(capacity, 0);
+            m_mask = capacity - 1;
+        }
+
+        bool isEnabled() const { return !m_keys.empty(); }
+
+        // a new game, a length 1 snake at headCell
+        void start(int headCell) {
+            m_hash = cellKey(headCell);
+            m_tailPower = 1;
+            forget();
+        }
+
+        // the head moved to headCell, the tail left tailCell
+        void shift(int headCell, int tailCell) {
+            m_hash = (m_hash - cellKey(tailCell) * m_tailPower) * c_base + cellKey(headCell);
+        }
+
+        // the head moved to headCell onto the apple, the tail stays
+        void grow(int headCell) {
+            m_hash = m_hash * c_base + cellKey(headCell);
+            m_tailPower *= c_base;
+            forget();
+        }
+
+        // records the state after a move, true when it was already seen since the last apple
+        bool repeated(int8_t direction) {
+            const uint64_t key = m_hash ^ mix(uint64_t(direction + 3));
+            for (uint32_t slot = uint32_t(key >> 32) & m_mask;; slot = (slot + 1) & m_mask) {
+                if (m_stamps[slot] != m_stamp) {
+                    m_keys[slot] = key;
+                    m_stamps[slot] = m_stamp;
+                    return false;
+                }
+                if (m_keys[slot] == key) {
+                    return true;
+                }
+            }
+        }
+
+    private:
+        static constexpr uint64_t c_base = 0x9e3779b97f4a7c15ULL; /* odd, a bijection mod 2^64 */
+
+        static uint64_t mix(uint64_t x) {
+            // splitmix64 finalizer
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+        static uint64_t cellKey(int cell) { return mix(uint64_t(cell) + 0x632be59bd9b4e019ULL); }
+
+        void forget() {
+            if (++m_stamp == 0) {
+                // wrapped, the old stamps could match again
+                std::fill(m_stamps.begin(), m_stamps.end(), 0);
+                m_stamp = 1;
+            }
+        }
+
+        uint64_t m_hash = 0;
+        uint64_t m_tailPower = 1; /* c_base ^ (length - 1) */
+        uint32_t m_mask = 0;
+        uint32_t m_stamp = 0;
+        std::vector<uint64_t> m_keys;
+        std::vector<uint32_t> m_stamps;
+    };
+
+} // namespace sim
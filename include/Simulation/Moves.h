@@ -0,0 +1,21 @@
+#pragma once
+
+namespace sim {
+
+    struct Delta {
+        int row;
+        int col;
+    };
+
+    // indexed by SnakeDirection raw value + 2: left, up, invalid, down, right
+    constexpr Delta c_moveDelta[5] = {{0, -1}, {-1, 0}, {0, 0}, {1, 0}, {0, 1}};
+
+    // SnakeDirection::toArray, same index
+    constexpr double c_directionVector[5][4] = {
+        {0, 0, 0, 1},
+        {1, 0, 0, 0},
+        {1, 1, 1, 1},
+        {0, 0, 1, 0},
+        {0, 1, 0, 0}};
+
+} // namespace sim
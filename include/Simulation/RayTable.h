@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Simulation/Bitboard.h"
+#include "Simulation/Vision.h"
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // the 8 vision rays of a board size, precomputed.
+    // ray r of a cell is the line through it (row, column or diagonal) clipped at
+    // the cell, so the nearest body / apple on it is one AND plus a bit scan of
+    // the few words the line touches, instead of a cell by cell walk.
+    class RayTable {
+    public:
+        static constexpr int c_rayNum = c_visionRayNum; /* in c_visionRay order */
+
+        // shared table of a board size, built on first use
+        static const RayTable &get(int row, int col);
+
+        RayTable(int row, int col);
+
+        // cells between the cell and the nearest set bit of plane on the ray
+        // (0 when it is adjacent), -1 when there is none
+        template <typename Plane>
+        int nearest(const Plane &plane, int cell, int ray) const;
+
+        // in bound cells on the ray
+        int wallDistance(int cell, int ray) const { return m_rays[cell * c_rayNum + ray].wallDistance; }
+
+        // the ray of from that passes through to and the cells between them, -1 when it is on none
+        int rayTo(int from, int to, int &distance) const;
+
+        int rowOf(int cell) const { return m_rowOf[cell]; }
+        int colOf(int cell) const { return m_colOf[cell]; }
+
+    private:
+        struct Ray {
+            uint64_t firstMask;   /* the line in the cell's own word, clipped at the cell */
+            int32_t line;         /* offset of the line mask in m_lineWords */
+            int16_t lastWord;     /* last word the ray reaches, scanning away from the cell */
+            int16_t wallDistance;
+        };
+
+        int m_wordNum;
+        int m_stride[c_rayNum];              /* cell index step of a ray */
+        std::vector<Ray> m_rays;             /* [cell * c_rayNum + ray] */
+        std::vector<uint64_t> m_lineWords;   /* columns, anti diagonals, rows, diagonals, m_wordNum words each */
+        std::vector<int16_t> m_rowOf;        /* [cell], steps along all but the row rays are rows */
+        std::vector<int16_t> m_colOf;        /* [cell] */
+    };
+
+    template <typename Plane>
+    inline int RayTable::nearest(const Plane &plane, int cell, int ray) const {
+        const Ray &r = m_rays[cell * c_rayNum + ray];
+        int w = cell >> 6;
+        uint64_t m = plane.word(w) & r.firstMask;
+
+        if (m_stride[ray] > 0) {
+            // the nearest one has the lowest index above the cell
+            while (0 == m) {
+                if (++w > r.lastWord) {
+                    return -1;
+                }
+                m = plane.word(w) & m_lineWords[r.line + w];
+            }
+            const int hit = w * 64 + lowestBit(m);
+            return (m_stride[ray] == 1 ? hit - cell : m_rowOf[hit] - m_rowOf[cell]) - 1;
+        }
+
+        // the highest index below the cell
+        while (0 == m) {
+            if (--w < r.lastWord) {
+                return -1;
+            }
+            m = plane.word(w) & m_lineWords[r.line + w];
+        }
+        const int hit = w * 64 + highestBit(m);
+        return (m_stride[ray] == -1 ? cell - hit : m_rowOf[cell] - m_rowOf[hit]) - 1;
+    }
+
+    inline int RayTable::rayTo(int from, int to, int &distance) const {
+        // ray index by {row, col} sign + 1
+        static constexpr int8_t c_rayOfSign[3][3] = {{7, 0, 1}, {6, -1, 2}, {5, 4, 3}};
+
+        const int dr = m_rowOf[to] - m_rowOf[from];
+        const int dc = m_colOf[to] - m_colOf[from];
+        const int ar = dr < 0 ? -dr : dr;
+        const int ac = dc < 0 ? -dc : dc;
+        if (ar != 0 && ac != 0 && ar != ac) {
+            return -1;
+        }
+
+        distance = (ar > ac ? ar : ac) - 1;
+        return c_rayOfSign[(dr > 0) - (dr < 0) + 1][(dc > 0) - (dc < 0) + 1];
+    }
+
+} // namespace sim
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Simulation/Bitboard.h"
+#include "Simulation/Vision.h"
+#include <cstdint>
+#include <vector>
+
+namespace sim {
+
+    // a body plane for large boards, in two levels: a word per 8x8 cell tile,
+    // and a summary word per 8x8 tiles with a bit for every tile that is not empty.
+    // the nearest body on a ray skips an empty block of 64x64 cells or an empty
+    // tile in one step and scans a tile with one AND, so the cost of a ray grows
+    // with the blocks it crosses instead of with the cells.
+    class TiledOccupancy {
+    public:
+        TiledOccupancy() = default;
+        TiledOccupancy(int row, int col);
+        // copies and moves out of line, inlined into the move of a game's optional
+        // tiles gcc takes them for reads of uninitialized memory
+        TiledOccupancy(const TiledOccupancy &);
+        TiledOccupancy(TiledOccupancy &&) noexcept;
+        TiledOccupancy &operator=(const TiledOccupancy &);
+        TiledOccupancy &operator=(TiledOccupancy &&) noexcept;
+
+        void set(int row, int col) {
+            const int tile = tileOf(row, col);
+            m_tiles[tile] |= uint64_t(1) << bitOf(row, col);
+            m_summary[summaryOf(row, col)] |= uint64_t(1) << summaryBitOf(row, col);
+        }
+        void reset(int row, int col) {
+            const int tile = tileOf(row, col);
+            m_tiles[tile] &= ~(uint64_t(1) << bitOf(row, col));
+            if (m_tiles[tile] == 0) {
+                m_summary[summaryOf(row, col)] &= ~(uint64_t(1) << summaryBitOf(row, col));
+            }
+        }
+        bool test(int row, int col) const { return (m_tiles[tileOf(row, col)] >> bitOf(row, col)) & 1; }
+
+        void clear();
+
+        // RayTable::nearest: cells between the cell and the nearest set one on
+        // the ray (0 when it is adjacent), -1 when there is none
+        int nearest(int row, int col, int ray) const;
+
+    private:
+        int tileOf(int row, int col) const { return (row >> 3) * m_tileCols + (col >> 3); }
+        int summaryOf(int row, int col) const { return (row >> 6) * m_summaryCols + (col >> 6); }
+        static int bitOf(int row, int col) { return (row & 7) * 8 + (col & 7); }
+        static int summaryBitOf(int row, int col) { return ((row >> 3) & 7) * 8 + ((col >> 3) & 7); }
+
+        // steps along (dr, dc) until (row, col) leaves its block of size x size cells
+        static int stepsToLeave(int row, int col, int dr, int dc, int size);
+
+    private:
+        int m_row = 0;
+        int m_col = 0;
+        int m_tileCols = 0;
+        int m_summaryCols = 0;
+        std::vector<uint64_t> m_tiles;   /* [tile row * m_tileCols + tile col] */
+        std::vector<uint64_t> m_summary; /* [block row * m_summaryCols + block col] */
+    };
+
+    inline int TiledOccupancy::stepsToLeave(int row, int col, int dr, int dc, int size) {
+        const int mask = size - 1;
+        const int rowSteps = dr > 0 ? size - (row & mask) : (dr < 0 ? (row & mask) + 1 : size);
+        const int colSteps = dc > 0 ? size - (col & mask) : (dc < 0 ? (col & mask) + 1 : size);
+        return rowSteps < colSteps ? rowSteps : colSteps;
+    }
+
+} // namespace sim
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Simulation/GameState.h"
+#include "Simulation/LoopDetector.h"
+#include "Simulation/RayTable.h"
+#include "Simulation/Vision.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace sim {
+
+    // how a game of a VecEnv ended
+    struct EpisodeResult {
+        unsigned int seed;
+        int32_t score;
+        int32_t totalSteps;
+        int32_t eatSteps;
+        StepResult end;
+    };
+
+    // many training games side by side, structure of arrays: the per game
+    // values are one array each and the boards are one block per game.
+    // step() moves every game at once: the move and wall check and the wander
+    // check and rewards are plain loops over the arrays, only the board update is
+    // per game. same rules and random numbers as HeadlessGame, a game started from
+    // a seed here is the game HeadlessGame plays from that seed.
+    //
+    // an observation is taken after a move, the way playGame thinks after each step:
+    // a new game already made its first, untaught move. a game that ends is
+    // reported through done() / episode() and starts over on the next seed.
+    // with auto reset off it stays over until reset(game, seed) is called.
+    // a game that ends on its first move is over after reset, episode() has it.
+    class VecEnv {
+    public:
+        static constexpr int c_visionSize = sim::c_visionSize;
+        static constexpr int c_directionSize = 4;
+        static constexpr int c_inputSize = c_visionSize + c_directionSize;
+
+        // the seeds of the games are drawn from seed
+        VecEnv(int gameNum, int row, int col, int wanderThreshold, unsigned int seed);
+
+        void reset();                            /* every game from a new seed */
+        void reset(int game, unsigned int seed); /* one game from the given seed */
+
+        // one move per game. directions[i] is a SnakeDirection raw value,
+        // invalid (0) keeps the current direction.
+        void step(const int8_t *directions);
+
+        // the network input of every game, size() x c_inputSize, game major
+        void buildInputs(double *inputs) const;
+        void buildInput(int game, double *input) const;
+
+        // on by default
+        void setAutoReset(bool autoReset) { m_autoReset = autoReset; }
+        // HeadlessGame::setLoopDetection for every game, off by default
+        void setLoopDetection(bool on);
+
+        int size() const { return m_gameNum; }
+        int getRow() const { return m_row; }
+        int getCol() const { return m_col; }
+
+        // of the last step: 1 for an apple, -1 for a death, 0 otherwise
+        const float *reward() const { return m_reward.data(); }
+        // of the last step: the game ended, episode(i) has its result and it was reset
+        const uint8_t *done() const { return m_done.data(); }
+        bool isAlive(int game) const { return m_alive[game]; }
+        const EpisodeResult &episode(int game) const { return m_episode[game]; }
+
+        const int32_t *score() const { return m_score.data(); }
+        const int32_t *totalSteps() const { return m_totalSteps.data(); }
+        unsigned int seedOf(int game) const { return m_seed[game]; }
+
+    private:
+        int randomNumber(int game, int low, int high);
+
+        void move(int game, int target); /* the board of one game, target < 0 hit the wall */
+        void addHead(int game, int cell);
+        int removeTail(int game);
+        void placeApple(int game);
+        void freeCell(int game, int cell);
+        void takeCell(int game, int cell);
+
+    private:
+        int m_gameNum;
+        int m_row;
+        int m_col;
+        int m_size;
+        int m_wordNum;
+        int m_wanderThreshold;
+
+        // per game
+        std::vector<int32_t> m_headRow;
+        std::vector<int32_t> m_headCol;
+        std::vector<int8_t> m_direction;
+        std::vector<int32_t> m_score;
+        std::vector<int32_t> m_totalSteps;
+        std::vector<int32_t> m_eatSteps;
+        std::vector<int32_t> m_length;
+        std::vector<int32_t> m_apple;
+        std::vector<int32_t> m_bodyHead;
+        std::vector<int32_t> m_freeNum;
+        std::vector<uint8_t> m_alive;
+        std::vector<uint8_t> m_last; /* StepResult */
+        std::vector<unsigned int> m_seed;
+        std::vector<std::minstd_rand> m_rng;
+        std::vector<LoopDetector> m_loops;
+
+        // per game blocks, game i at [i * m_size] / [i * m_wordNum]
+        std::vector<uint8_t> m_cells;     /* Cell */
+        std::vector<int32_t> m_body;      /* ring buffer, head at m_bodyHead */
+        std::vector<int32_t> m_freeCells; /* FreeCellSet */
+        std::vector<int32_t> m_freeSlot;
+        std::vector<uint64_t> m_planes;   /* body planes */
+
+        // step results and scratch
+        std::vector<int32_t> m_target;
+        std::vector<float> m_reward;
+        std::vector<uint8_t> m_done;
+        std::vector<EpisodeResult> m_episode;
+
+        bool m_autoReset;
+        std::minstd_rand m_seedRng;
+
+        const RayTable *m_rays;
+        std::vector<double> m_wallValue;
+        std::vector<double> m_bodyValue;
+        std::vector<double> m_foodValue;
+    };
+
+} // namespace sim
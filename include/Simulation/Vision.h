@@ -0,0 +1,85 @@
+#pragma once
+
+namespace sim {
+
+    // the snake looks along 8 rays, {wall, body, food} for each
+    constexpr int c_visionRayNum = 8;
+    constexpr int c_visionSize = c_visionRayNum * 3;
+
+    // {row, col} step of a ray, same order as SnakeBrain::visionChangeList
+    constexpr int c_visionRay[c_visionRayNum][2] = {
+        {-1, 0},  /* 00:00 */
+        {-1, 1},  /* 01:30 */
+        {0, 1},   /* 03:00 */
+        {1, 1},   /* 04:30 */
+        {1, 0},   /* 06:00 */
+        {1, -1},  /* 07:30 */
+        {0, -1},  /* 09:00 */
+        {-1, -1}, /* 10:30 */
+    };
+
+    inline double wallValue(const double wallDistance, const int totalBlockSize) {
+        return wallDistance / double(totalBlockSize - 1);
+    }
+
+    inline double bodyValue(const double bodyDistance, const int totalBlockSize) {
+        if (-1 == bodyDistance) {
+            //该方向上没有蛇身
+            return 1.0;
+        } else {
+            return bodyDistance / double(totalBlockSize - 1.0);
+        }
+    }
+
+    inline double foodValue(const double foodDistance, const int totalBlockSize) {
+        if (-1 == foodDistance) {
+            //该方向上没有苹果
+            return 0.0;
+        } else {
+            return (totalBlockSize - foodDistance - 1.0) / (totalBlockSize - 1.0);
+        }
+    }
+
+    // the vision by walking every ray from the head cell by cell.
+    // SnakeBrain::buildVisionVector runs it on the PlayboardModel, the headless
+    // engine on its own cells as the reference for the faster builders.
+    template <typename IsSnake, typename IsApple>
+    void walkVision(int headRow, int headCol, int row, int col, IsSnake &&isSnake, IsApple &&isApple, double *vision) {
+        for (const auto &v : c_visionRay) {
+            int wallDistance = -1, bodyDistance = -1, foodDistance = -1;
+
+            int tempRow = headRow;
+            int tempCol = headCol;
+
+            int wallStep = 1;
+            int foodStep = 0;
+            int snakeStep = 0;
+
+            while (tempRow += v[0], tempCol += v[1], tempRow >= 0 && tempRow < row && tempCol >= 0 && tempCol < col) {
+
+                if (isSnake(tempRow, tempCol) && bodyDistance == -1) {
+                    bodyDistance = snakeStep;
+                }
+
+                if (isApple(tempRow, tempCol) && foodDistance == -1) {
+                    foodDistance = foodStep;
+                }
+
+                wallDistance = wallStep;
+
+                wallStep++;
+                foodStep++;
+                snakeStep++;
+            }
+
+            if (wallDistance == -1) {
+                wallDistance = 0;
+            }
+
+            *vision++ = wallValue(wallDistance, row);
+            *vision++ = bodyValue(bodyDistance, row);
+            *vision++ = foodValue(foodDistance, row);
+        }
+    }
+
+} // namespace sim
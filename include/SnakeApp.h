@@ -5,6 +5,7 @@
 #include <string>
 
 #include "FPSTimer.h"
+#include "GameSettings.h"
 #include "InfoboardModel.h"
 #include "PlayboardModel.h"
 #include "UIManager.h"
@@ -46,9 +47,13 @@ class SnakeApp : public Observable<SnakeApp>,
                  public Observer<UIManager> {
 public:
     SnakeApp();
+    explicit SnakeApp(std::shared_ptr<const GameSettings> settings);
     ~SnakeApp();
 
     int start();
+    // train mode, run at most maxSteps updates (<= 0 for no limit).
+    // the game can be resumed with another call, returns true once it ended.
+    bool runTrainSlice(int maxSteps);
 
 private:
     // GameApp basic structure
@@ -66,7 +71,7 @@ private:
     void onExit();
     void onCleanup();
 
-    void field_changed(UIManager &source, const string &field_name);
+    void field_changed(UIManager &source, UIEvent::Type event);
 
 public:
     std::shared_ptr<PlayboardModel> getPlayboardModel() { return m_playboard; }
@@ -76,10 +81,12 @@ public:
     SnakeAppState getState() { return state; }
     void setState(SnakeAppState state) {
         this->state = state;
-        this->notify(*this, "state");
+        this->notify(*this, AppEvent::state);
     }
 
 private:
+    std::shared_ptr<const GameSettings> m_settings;
+
     bool running;
     SnakeAppState state;
 
@@ -19,6 +19,9 @@ public:
     void buildVisionVector(std::vector<double> &visionVector, const BlockPosition &head, const BlockPosition &apple, const int row, const int col);
 
     SnakeDirection think(std::vector<double> &vision);
+    SnakeDirection think(const double *input, int inputSize);
+    // the move for the output layer values, invalid when they make no sense
+    static SnakeDirection directionOf(const double *output, int outputSize);
 
     std::shared_ptr<NeuralNetwork> getNeuralNetwork() { return m_nn; }
 
@@ -26,10 +29,6 @@ public:
     static std::vector<std::vector<int>> visionChangeList;
 
 private:
-    inline double wallValue(const double wallDistance, const int totalBlockSize);
-    inline double bodyValue(const double bodyDistance, const int totalBlockSize);
-    inline double foodValue(const double foodDistance, const int totalBlockSize);
-
     SnakeDirection randomDirection();
     void initWeightMatrixLenList(std::vector<int> &list);
     void initLayerActivateType();
@@ -39,6 +38,7 @@ private:
 
     // neural network
     std::shared_ptr<NeuralNetwork> m_nn;
+    std::vector<double> m_output; /* output layer values of the last think */
 
     // GA mutate
     std::vector<int> m_weightMatrixLenList;
@@ -1,11 +1,8 @@
 #pragma once
 
+#include <array>
 #include <glog/logging.h>
-#include <map>
 #include <string>
-#include <vector>
-
-typedef std::map<int8_t, std::vector<int>> DirectionChangeMap;
 
 class SnakeDirection {
 public:
@@ -17,8 +14,6 @@ public:
         right = 2
     };
 
-    static DirectionChangeMap changeMap;
-
     SnakeDirection() = default;
     SnakeDirection(int adirection) { direction = Direction(adirection); }
     constexpr SnakeDirection(Direction adirection) : direction(adirection) {}
@@ -44,21 +39,37 @@ public:
         }
     }
 
-    std::vector<double> toVector() {
+    // {row, col} of one move in this direction
+    constexpr std::array<int, 2> toChange() const {
+        switch (direction) {
+        case up:
+            return {-1, 0};
+        case down:
+            return {1, 0};
+        case left:
+            return {0, -1};
+        case right:
+            return {0, 1};
+        default:
+            return {0, 0};
+        }
+    }
+
+    std::array<double, 4> toArray() const {
 
         switch (direction) {
         case up:
-            return std::vector<double>{1, 0, 0, 0};
+            return {1, 0, 0, 0};
         case right:
-            return std::vector<double>{0, 1, 0, 0};
+            return {0, 1, 0, 0};
         case down:
-            return std::vector<double>{0, 0, 1, 0};
+            return {0, 0, 1, 0};
         case left:
-            return std::vector<double>{0, 0, 0, 1};
+            return {0, 0, 0, 1};
 
         default:
-            LOG(ERROR) << "SnakeDirection::toVector Wrong direction.";
-            return std::vector<double>{1, 1, 1, 1};
+            LOG(ERROR) << "SnakeDirection::toArray Wrong direction.";
+            return {1, 1, 1, 1};
         }
     }
 
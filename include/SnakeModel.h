@@ -3,8 +3,8 @@
 #include <SDL2/SDL.h>
 #include <glog/logging.h>
 
-#include "AppConfig.h"
 #include "BlockModel.h"
+#include "GameSettings.h"
 #include "Observer/Observer.h"
 #include "SnakeBrain.h"
 #include "SnakeDirection.h"
@@ -17,7 +17,6 @@
 class SnakeBrain;
 class SnakeBlock;
 class PlayboardModel;
-class AppConfig;
 class SnakeApp;
 
 class SnakeModel : public Observable<SnakeModel>,
@@ -27,12 +26,12 @@ class SnakeModel : public Observable<SnakeModel>,
     friend SnakeApp;
 
 public:
-    SnakeModel();
+    explicit SnakeModel(std::shared_ptr<const GameSettings> settings);
     ~SnakeModel();
 
     void update();
     void initSnake();
-    void setDefaultMoveInterval() { setMoveInterval(AppConfig::InitInterval()); }
+    void setDefaultMoveInterval() { setMoveInterval(m_settings->initInterval); }
     int getMoveInterval() { return m_moveInterval; }
 
 public:
@@ -57,7 +56,7 @@ public:
     int getTotalStepCount() { return m_totalStepCount; }
     void setDirection(SnakeDirection d) {
 
-        if (AppConfig::RunMode().isHumanMode()) {
+        if (m_settings->runMode.isHumanMode()) {
             // human play mode
             // should not move opposite the current direction
             // this means snake will bite itself imediately
@@ -73,14 +72,14 @@ public:
             m_currDirection = d;
         }
 
-        this->notify(*this, "direction");
+        this->notify(*this, SnakeEvent::direction);
     }
 
     SnakeDirection getCurrentDirection() { return m_currDirection; }
 
     void setNextDirection(SnakeDirection next) {
         m_nextDirection = next;
-        this->notify(*this, "nextDirection");
+        this->notify(*this, SnakeEvent::nextDirection);
     }
     SnakeDirection getNextDirection() { return m_nextDirection; }
 
@@ -90,7 +89,7 @@ public:
     SnakeState getState() { return m_state; }
     void setState(SnakeState s) {
         m_state = s;
-        this->notify(*this, "state");
+        this->notify(*this, SnakeEvent::state);
     }
 
     std::string getStateInfo() { return m_stateInfo; }
@@ -109,17 +108,22 @@ private:
 
     void setScore(int score) {
         m_score = score;
-        this->notify(*this, "score");
+        this->notify(*this, SnakeEvent::score);
     }
 
     void setTotalStepCount(int stepCount) {
         m_totalStepCount = stepCount;
-        this->notify(*this, "stepCount");
+        this->notify(*this, SnakeEvent::stepCount);
     }
 
     void addHeadBlock();
     void removeTailBlock();
 
+private:
+    // update() for one run mode
+    template <AppRunMode::Mode mode>
+    void updateIn();
+
 private:
     // what a snake should do
     void playStep();
@@ -141,9 +145,11 @@ private:
 
 private:
     // observer
-    void field_changed(PlayboardModel &source, const string &field_name);
+    void field_changed(PlayboardModel &source, PlayboardEvent::Type event);
 
 private:
+    std::shared_ptr<const GameSettings> m_settings;
+
     int m_score;
     int m_totalStepCount;
     int m_eatStepCount;
@@ -165,6 +171,7 @@ private:
 
     std::deque<SnakeBlock> m_snakeBodyQueue;
     std::shared_ptr<SnakeBrain> m_brain;
+    std::vector<double> m_input; /* network input of thinking() */
 
     std::chrono::time_point<std::chrono::high_resolution_clock> m_lastMoveTime;
 };
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+class ThreadAffinity {
+public:
+    enum Policy : int {
+        none = 0,    // let the OS schedule the workers
+        compact = 1, // fill the SMT siblings of one core before moving to the next
+        scatter = 2  // one worker per physical core first, siblings last
+    };
+
+    ThreadAffinity() = default;
+    constexpr ThreadAffinity(Policy apolicy) : policy(apolicy) {}
+
+    // none for an unknown name, with a warning
+    static ThreadAffinity fromString(const std::string &name);
+
+    std::string description() const {
+        switch (policy) {
+        case compact:
+            return "compact";
+        case scatter:
+            return "scatter";
+        default:
+            return "none";
+        }
+    }
+
+    constexpr operator Policy() const { return policy; }
+    explicit operator bool() const = delete;
+
+private:
+    Policy policy = none;
+};
+
+struct CpuInfo {
+    int cpu;     // logical cpu id, what the affinity mask talks about
+    int core;    // physical core id inside the package
+    int package; // socket
+};
+
+// what this process may actually run on.
+// inside a container std::thread::hardware_concurrency() reports the host,
+// the affinity mask and the cgroup cpu quota are what count.
+class CpuTopology {
+public:
+    static CpuTopology detect();
+
+    int hardwareThreads() const { return m_hardwareThreads; }
+    int allowedCpuNum() const { return m_cpus.size(); }
+    double cpuQuota() const { return m_cpuQuota; } /* <= 0 means no quota */
+    int effectiveCpuNum() const;
+
+    const std::vector<CpuInfo> &cpus() const { return m_cpus; }
+
+    // cpu ids to pin threadNum workers to, empty for ThreadAffinity::none
+    std::vector<int> pinOrder(ThreadAffinity affinity, int threadNum) const;
+
+    std::string description() const;
+
+private:
+    int m_hardwareThreads = 1;
+    double m_cpuQuota = 0;
+    std::vector<CpuInfo> m_cpus;
+};
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// move-only void() callable.
+// small closures (the usual [&] / [this] lambdas) are stored inline,
+// bigger ones fall back to one heap allocation.
+class Task {
+public:
+    static constexpr std::size_t c_inlineSize = 48;
+
+    Task() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>>
+    Task(F &&f) {
+        using Fn = std::decay_t<F>;
+        if constexpr (fitsInline<Fn>()) {
+            ::new (static_cast<void *>(m_storage)) Fn(std::forward<F>(f));
+            m_ops = &s_inlineOps<Fn>;
+        } else {
+            ::new (static_cast<void *>(m_storage)) Fn *(new Fn(std::forward<F>(f)));
+            m_ops = &s_heapOps<Fn>;
+        }
+    }
+
+    Task(Task &&other) noexcept { moveFrom(other); }
+
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task() { reset(); }
+
+    explicit operator bool() const { return m_ops != nullptr; }
+
+    void operator()() { m_ops->invoke(m_storage); }
+
+    void reset() {
+        if (m_ops) {
+            m_ops->destroy(m_storage);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    struct Ops {
+        void (*invoke)(void *storage);
+        void (*move)(void *dst, void *src);
+        void (*destroy)(void *storage);
+    };
+
+    template <typename Fn>
+    static constexpr bool fitsInline() {
+        return sizeof(Fn) <= c_inlineSize && alignof(Fn) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Fn>;
+    }
+
+    template <typename Fn>
+    static inline const Ops s_inlineOps{
+        [](void *s) { (*std::launder(static_cast<Fn *>(s)))(); },
+        [](void *dst, void *src) {
+            Fn *from = std::launder(static_cast<Fn *>(src));
+            ::new (dst) Fn(std::move(*from));
+            from->~Fn();
+        },
+        [](void *s) { std::launder(static_cast<Fn *>(s))->~Fn(); }};
+
+    template <typename Fn>
+    static inline const Ops s_heapOps{
+        [](void *s) { (**static_cast<Fn **>(s))(); },
+        [](void *dst, void *src) { ::new (dst) Fn *(*static_cast<Fn **>(src)); },
+        [](void *s) { delete *static_cast<Fn **>(s); }};
+
+    void moveFrom(Task &other) {
+        if (other.m_ops) {
+            other.m_ops->move(m_storage, other.m_storage);
+            m_ops = other.m_ops;
+            other.m_ops = nullptr;
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char m_storage[c_inlineSize];
+    const Ops *m_ops = nullptr;
+};
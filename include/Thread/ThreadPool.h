@@ -1,25 +1,171 @@
 #pragma once
-#include <functional>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <thread>
+#include <algorithm>
 #include <vector>
 
+#include "Thread/Task.h"
+
+// work stealing thread pool
+// every worker owns a deque, it pops its own jobs from the back and
+// steals from the front of the other workers' deques when it runs dry.
 class ThreadPool {
 public:
     ThreadPool();
+    explicit ThreadPool(uint32_t threadNum, const std::vector<int> &pinCpus = {});
     ~ThreadPool();
 
-    void queueJob(const std::function<void()> &job);
+    void queueJob(Task job);
+    void queueJobs(std::vector<Task> &jobs); /* bulk submission, jobs is left empty */
     void done();
     bool isBusy();
-    void join();    /* TODO: wait all job finish */
+    void join(); /* wait all queued jobs finish, must not be called from a job */
+
+    uint32_t size() { return threads.size(); }
+    const std::vector<int> &pinnedCpus() { return pinned_cpus; } /* cpu of worker i (-1 unpinned), empty when pinning is off */
+
+    // run fn(i) for i in [begin, end).
+    // the range is handed out in shrinking chunks of at least grain items, the
+    // calling thread takes chunks too and returns once every chunk has run,
+    // whichever thread ran it.
+    template <typename Fn>
+    void parallelFor(int begin, int end, int grain, Fn &&fn);
+
+    // combine(identity, map(i)...) over [begin, end).
+    // partials are kept per block of grain items and folded in block order,
+    // the result does not depend on the thread count. every partial sits in
+    // its own cache line, blocks finishing together do not share one.
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(int begin, int end, int grain, T identity, Map &&map, Combine &&combine);
 
 private:
-    void threadLoop();
+    // shared by the calling thread and the helper jobs of one parallelFor
+    struct ParallelRange {
+        std::atomic<int> next;
+        int end;
+        int grain;
+        int participants;
+        std::atomic<int> remaining;
+        std::mutex mutex;
+        std::condition_variable finished;
+
+        bool claim(int &first, int &last);
+        void complete(int count);
+        void wait();
+    };
+
+    template <typename T>
+    struct alignas(64) Partial {
+        T value;
+    };
 
-    bool should_terminate = false;           // Tells threads to stop looking for jobs
-    std::mutex queue_mutex;                  // Prevents data races to the job queue
-    std::condition_variable mutex_condition; // Allows threads to wait on new jobs or termination
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> jobs;
+    };
+
+    void start(uint32_t threadNum);
+    bool pinThread(std::thread &thread, int cpu);
+    void threadLoop(uint32_t index);
+
+    bool popJob(uint32_t index, Task &job);
+    bool stealJob(uint32_t index, Task &job, bool wait); /* wait: lock every victim instead of skipping a locked one */
+    void runJob(Task &job);
+    void wakeWorkers(size_t count);
+    uint32_t submitIndex();
+
+    bool should_terminate = false;            // Tells threads to stop looking for jobs
+    std::mutex sleep_mutex;                   // Guards sleeping workers against lost wake ups
+    std::condition_variable sleep_condition;  // Allows threads to wait on new jobs or termination
+    std::mutex idle_mutex;                    // Guards join() waiting for the pool to drain
+    std::condition_variable idle_condition;   // Signals all pending jobs finished
+    std::atomic<int> queued_jobs{0};          // jobs sitting in worker deques
+    std::atomic<int> pending_jobs{0};         // queued + running jobs
+    std::atomic<uint32_t> next_worker{0};     // round robin target for external submission
+    std::vector<std::unique_ptr<Worker>> workers;
     std::vector<std::thread> threads;
-    std::queue<std::function<void()>> jobs;
-};
\ No newline at end of file
+    std::vector<int> pinned_cpus;
+};
+
+template <typename Fn>
+void ThreadPool::parallelFor(int begin, int end, int grain, Fn &&fn) {
+    if (begin >= end) {
+        return;
+    }
+
+    grain = std::max(grain, 1);
+    const int total = end - begin;
+    const int helperNum = std::min<int>(size(), (total - 1) / grain);
+
+    auto range = std::make_shared<ParallelRange>();
+    range->next = begin;
+    range->end = end;
+    range->grain = grain;
+    range->participants = helperNum + 1;
+    range->remaining = total;
+
+    auto body = [&fn](int first, int last) {
+        for (int i = first; i < last; i++) {
+            fn(i);
+        }
+    };
+
+    if (helperNum > 0) {
+        std::vector<Task> helpers;
+        helpers.reserve(helperNum);
+        for (int h = 0; h < helperNum; h++) {
+            // body is only touched after a successful claim, and the caller
+            // can not return before every claimed chunk completed.
+            helpers.emplace_back([range, run = &body]() {
+                int first, last;
+                while (range->claim(first, last)) {
+                    (*run)(first, last);
+                    range->complete(last - first);
+                }
+            });
+        }
+        queueJobs(helpers);
+    }
+
+    int first, last;
+    while (range->claim(first, last)) {
+        body(first, last);
+        range->complete(last - first);
+    }
+
+    range->wait();
+}
+
+template <typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(int begin, int end, int grain, T identity, Map &&map, Combine &&combine) {
+    if (begin >= end) {
+        return identity;
+    }
+
+    grain = std::max(grain, 1);
+    const int blockNum = (end - begin + grain - 1) / grain;
+    std::vector<Partial<T>> partials(blockNum, Partial<T>{identity});
+
+    parallelFor(0, blockNum, 1, [&](int block) {
+        const int first = begin + block * grain;
+        const int last = std::min(first + grain, end);
+
+        T acc = identity;
+        for (int i = first; i < last; i++) {
+            acc = combine(acc, map(i));
+        }
+        partials[block].value = acc;
+    });
+
+    T result = identity;
+    for (const Partial<T> &partial : partials) {
+        result = combine(result, partial.value);
+    }
+
+    return result;
+}
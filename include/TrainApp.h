@@ -1,6 +1,15 @@
 #pragma once
 
+#include "GameSettings.h"
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Simulation/HeadlessGame.h"
+#include "Thread/CpuTopology.h"
 #include "Thread/ThreadPool.h"
+#include "Training/EvalContext.h"
+#include "Training/FitnessCache.h"
+#include "Training/Genome.h"
+#include "Training/Individual.h"
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <nlohmann/json.hpp>
@@ -9,8 +18,6 @@
 namespace fs = std::filesystem;
 using json = nlohmann::json;
 
-class SnakeApp;
-
 class TrainApp {
 
 public:
@@ -19,12 +26,35 @@ public:
 
     int start();
 
+    const CpuTopology &getCpuTopology() { return m_cpuTopology; }
+
+    // with a master seed the calling thread draws stream index of this generation's
+    // purpose next, what a task draws does not depend on the thread that runs it.
+    // a steady state child is numbered from the generation its run started in, not
+    // within a generation, its streams have tags of their own
+    enum class RandomStream {
+        initialWeights,
+        gameSeeds,
+        crossover,
+        mutate,
+        steadyCrossover,
+        steadyMutate,
+        steadyGameSeeds,
+    };
+
+    // the stream number of (purpose, generation, index). every field is mixed in
+    // whole with splitmix64, none can run into the next however large it gets
+    static uint64_t streamKey(RandomStream stream, int generation, long long index);
+
 private:
     void training();
     void trainingImpl();
+    void trainingSteadyStateImpl();
     void evaluate();
     void evaluateImpl();
+    void runEvaluationJobs();
     void samplingEvaluateResult();
+    void budgetGeneration();
     void selection();
     void selectionImpl();
     void crossover();
@@ -34,22 +64,25 @@ private:
 
 private:
     // helpers
+    void initThreadPool();
     void initMutateTable();
     void initPopulation();
     void initSamples();
 
-    bool waitDieOut();
-    bool waitCrossover(int crossoverCount);
-    int RouletteWheelSelection(const std::vector<std::shared_ptr<SnakeApp>> &population, const long double &fitnessSum);
+    void reseed(RandomStream stream, long long index);
+    void reseed(RandomStream stream, int generation, long long index);
+
+    int RouletteWheelSelection(const std::vector<ga::Individual> &population, const long double &fitnessSum);
     void saveSamples();
+    std::string memoryReport();
 
     void createTrainingTaskDir();
     void createGenerationDir(int gen, fs::path &generationDir);
 
     void reportGenerationInfo(int generation);
-    void buildTrainingInfo(json &authorInfo, const std::shared_ptr<SnakeApp> &snakeApp);
-    void selectPopulationTo(std::vector<std::shared_ptr<SnakeApp>> &target, int size);
-    void saveTrainingResults(const std::vector<std::shared_ptr<SnakeApp>> &src, int gen);
+    void buildTrainingInfo(json &authorInfo, const ga::Individual &individual);
+    void selectPopulationTo(std::vector<ga::Individual> &target, ga::GenomeStore &targetGenomes, int size);
+    void saveTrainingResults(const std::vector<ga::Individual> &src, const ga::GenomeStore &genomes, int gen);
 
     void updateLatestSaveGenInfo(int gen);
     void updateLatestNNFile(int gen);
@@ -64,6 +97,7 @@ private:
     int m_sampleSize;
 
     int m_generation;
+    unsigned int m_masterSeed = 0;
 
     long double m_samplesFitnessSum = 0;
 
@@ -74,8 +108,30 @@ private:
 
     std::vector<double> m_mutateValueTable;
 
-    std::vector<std::shared_ptr<SnakeApp>> m_population;
-    std::vector<std::shared_ptr<SnakeApp>> m_samples;
+    // parallelFor grain for per individual work that is much cheaper than a game
+    const int c_cheapJobGrain = 64;
+    const int c_breedJobGrain = 4;
+    const int c_parentDraws = 64; /* roulette draws for a parent before crossover falls back to a neighbour */
+
+    // the generation budget lifts a step cap at its maximum when budget / spent is at least this
+    const double c_budgetLiftRatio = 1.25;
+
+    // the population is plain records, the weights sit in one genome block,
+    // a game exists only while it is played in the evaluation context of a thread
+    std::vector<ga::Individual> m_population; /* sorted by fitness after evaluate */
+    std::vector<ga::Individual> m_samples;    /* the selected parents, their genomes copied to m_sampleGenomes */
+    ga::GenomeStore m_genomes;
+    ga::GenomeStore m_sampleGenomes;
+    uint32_t m_nextId = 0;
+    int m_eliteCount = 0; /* the last m_eliteCount of m_population are carried over samples, not mutated */
+    ga::FitnessCache m_fitnessCache;
+
+    std::shared_ptr<const GameSettings> m_settings;
+    std::vector<std::unique_ptr<ga::EvalContext>> m_contexts; /* one per pool thread */
+    std::vector<sim::HeadlessGame> m_parkedGames;              /* sliced games waiting for their next slice */
+    std::vector<int> m_freeParked;
+    std::vector<unsigned int> m_evaluationSeeds;                /* the shared seeds of the last evaluation, several games per individual */
+    std::unique_ptr<NeuralNetwork> m_ioNetwork;                /* a genome is loaded into it to be saved */
 
     std::chrono::time_point<std::chrono::high_resolution_clock> m_trainStartTime;
     std::chrono::time_point<std::chrono::high_resolution_clock> m_trainEndTime;
@@ -85,7 +141,18 @@ private:
     std::chrono::time_point<std::chrono::high_resolution_clock> m_generationEndTime;
     std::chrono::duration<double, std::milli> m_generationDuration;
 
+    CpuTopology m_cpuTopology;
     ThreadPool *m_pool;
+    double m_evaluateIdleCoreMs = 0;
+
+    // the generation budget: what the next generation plays, what the last one played
+    int m_targetPopulation;           /* crossed children per generation, PopulationSize() without a budget */
+    int m_stepCap = 0;                /* steps a game may play, 0 for no limit */
+    long long m_evaluateSteps = 0;
+    int m_evaluateLongestGame = 0;
+    int m_evaluateCapped = 0;
+    double m_breedMs = 0;
+    double m_evaluateTailMs = 0;
     bool m_trainTaskDone;
 
     fs::path m_trainingDataPath;
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "GameSettings.h"
+#include "Simulation/HeadlessGame.h"
+#include "Simulation/LaneEvaluator.h"
+#include "SnakeBrain.h"
+#include <memory>
+
+namespace ga {
+
+    // what a training thread needs to play the games of any individual, built once
+    // per thread and reused: the game, a network the genome is loaded into, and
+    // with inferenceLanes > 0 a LaneEvaluator.
+    class EvalContext {
+    public:
+        EvalContext(const GameSettings &settings, int inferenceLanes, bool loopDetection);
+
+        sim::HeadlessGame &game() { return m_game; }
+        SnakeBrain &brain() { return m_brain; }
+        sim::LaneEvaluator *lanes() { return m_lanes.get(); }
+
+        void loadGenome(const double *genome);
+
+        // roughly what one context costs: the objects and the weights, not the buffers behind them
+        size_t approxBytes() const;
+
+    private:
+        sim::HeadlessGame m_game;
+        SnakeBrain m_brain;
+        std::unique_ptr<sim::LaneEvaluator> m_lanes;
+        int m_genomeSize;
+    };
+
+} // namespace ga
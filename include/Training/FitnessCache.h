@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+namespace ga {
+
+    // the results of finished evaluations by genome and seed set. with a fixed
+    // evaluation seed a genome that did not change plays the same game again,
+    // an elite carried over or a child equal to a parent takes its result from here.
+    // an entry lives as long as some generation asks for it, what the last
+    // generation did not use is dropped.
+    class FitnessCache {
+    public:
+        struct Result {
+            int32_t score;
+            int32_t totalSteps;
+            int32_t eatSteps;
+            long double fitness;
+        };
+
+        static uint64_t key(uint64_t genomeHash, uint64_t seedSet);
+
+        void nextGeneration();
+        bool lookup(uint64_t key, Result &result);
+        void insert(uint64_t key, const Result &result);
+
+        size_t size() const { return m_current.size() + m_previous.size(); }
+
+    private:
+        std::unordered_map<uint64_t, Result> m_current;  /* used by this generation */
+        std::unordered_map<uint64_t, Result> m_previous; /* the last generation's */
+    };
+
+} // namespace ga
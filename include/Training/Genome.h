@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class NeuralNetwork;
+
+namespace ga {
+
+    // the weights of one network as one flat array: the weight matrices in layer
+    // order, each row major. it is the order SnakeBrain::mutate numbers them in and
+    // the order crossover walks them in.
+    int genomeSize(const std::vector<int> &topology);
+    void copyFromNetwork(NeuralNetwork &nn, double *genome);
+    void copyToNetwork(const double *genome, NeuralNetwork &nn);
+
+    // SnakeBrain::mutate on a genome, same random numbers and the same changes
+    void mutate(double *genome, int genomeSize, const std::vector<double> &mutateValueTable);
+
+    // of the weight bits, equal genomes hash equal
+    uint64_t genomeHash(const double *genome, int genomeSize);
+
+    // the genomes of a whole population in one block, slot i at [i * genomeSize()]
+    class GenomeStore {
+    public:
+        GenomeStore() = default;
+        explicit GenomeStore(const std::vector<int> &topology, int count = 0);
+
+        void resize(int count);
+
+        double *at(int slot) { return &m_values[size_t(slot) * m_genomeSize]; }
+        const double *at(int slot) const { return &m_values[size_t(slot) * m_genomeSize]; }
+
+        int size() const { return m_count; }
+        int genomeSize() const { return m_genomeSize; }
+        const std::vector<int> &topology() const { return m_topology; }
+        size_t bytes() const { return m_values.capacity() * sizeof(double); }
+
+    private:
+        std::vector<int> m_topology;
+        int m_genomeSize = 0;
+        int m_count = 0;
+        std::vector<double> m_values;
+    };
+
+} // namespace ga
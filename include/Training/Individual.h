@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ga {
+
+    // one member of the training population. the weights live in a GenomeStore,
+    // the game is played in a per thread EvalContext, this is all that is kept per snake.
+    struct Individual {
+        uint32_t id;            /* unique in the run */
+        uint32_t parents[2];    /* ids of the parents, c_noParent for the first generation */
+        int32_t genome;         /* slot in the GenomeStore of its population */
+        int32_t score;
+        int32_t totalSteps;
+        int32_t eatSteps;
+        int32_t expectedSteps;  /* LPT hint, the mean lifetime of the parents */
+        uint32_t seed;          /* of its last evaluation's (first) game, replays it with the genome */
+        long double fitness;
+
+        static constexpr uint32_t c_noParent = UINT32_MAX;
+    };
+
+} // namespace ga
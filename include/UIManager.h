@@ -25,9 +25,9 @@ public:
     void update();
     void reset();
 
-    void field_changed(InfoboardModel &source, const string &field_name);
-    void field_changed(PlayboardModel &source, const string &field_name);
-    void field_changed(SnakeModel &source, const string &field_name);
+    void field_changed(InfoboardModel &source, InfoboardEvent::Type event);
+    void field_changed(PlayboardModel &source, PlayboardEvent::Type event);
+    void field_changed(SnakeModel &source, SnakeEvent::Type event);
 
 public:
     SDL_Renderer *getRenderer();
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <chrono>
 #include <fmt/core.h>
 #include <functional>
 #include <iostream>
+#include <iterator>
+#include <memory_resource>
 #include <random>
 #include <sstream>
+#include <string>
+#include <string_view>
 
 namespace uuid {
     std::string generate_uuid_v4();
@@ -15,8 +20,42 @@ namespace utility {
     namespace random {
         int generateRandomNumber(int low, int high);
         double generateRandomDouble(double low, double high);
+        void seed(unsigned int value); /* reseed the calling thread's generators */
+        // reseed the calling thread's generator to stream of master: the numbers
+        // drawn after it depend on (master, stream) only, not on the thread
+        void seed(uint64_t master, uint64_t stream);
     }; // namespace random
 
+    // operator new calls, counted only in a build configured with SNAKE_COUNT_ALLOCATIONS=ON
+    namespace alloc {
+        bool enabled();
+        unsigned long long threadCount(); /* by the calling thread */
+        unsigned long long totalCount();  /* by every thread */
+    }; // namespace alloc
+
+    // a bump arena per thread for what lives no longer than one generation:
+    // scratch arrays, log lines. a thread starts its own arena over with
+    // resetArena(), at a point where nothing it allocated from it is alive, the
+    // generation barrier of the thread that runs the training loop.
+    // an arena grows its block to the largest generation it has seen, so once
+    // warmed up a generation does not reach the global allocator at all.
+    // memory from one thread's arena must only grow on that thread, and only that
+    // thread may reset it. a debug build checks that nothing is alive at a reset.
+    namespace memory {
+        std::pmr::memory_resource *generationResource(); /* the calling thread's arena */
+        void resetArena();                               /* the calling thread's arena */
+        unsigned long long arenaBytes();    /* the blocks of every thread */
+        unsigned long long overflowBytes(); /* taken past the blocks, by every thread since the start */
+
+        // fmt::format into the calling thread's arena
+        template <typename... Args>
+        std::pmr::string format(fmt::format_string<Args...> format, Args &&...args) {
+            std::pmr::string result(generationResource());
+            fmt::format_to(std::back_inserter(result), format, std::forward<Args>(args)...);
+            return result;
+        }
+    }; // namespace memory
+
     namespace time {
         // https://stackoverflow.com/questions/42138599/how-to-format-stdchrono-durations
         template <class... Durations, class DurationIn>
@@ -31,6 +70,8 @@ namespace utility {
         }
 
         void measure(const std::string &label, std::string &result, std::function<void()> const &lambda);
+        // the same, the result written with result's allocator
+        void measure(std::string_view label, std::pmr::string &result, std::function<void()> const &lambda);
 
         void measure(std::chrono::time_point<std::chrono::high_resolution_clock> &start,
                      std::chrono::time_point<std::chrono::high_resolution_clock> &end,
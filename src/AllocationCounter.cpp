@@ -0,0 +1,45 @@
+#include "Utility.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<unsigned long long> g_totalCount{0};
+    thread_local unsigned long long t_threadCount = 0;
+} // namespace
+
+namespace utility::alloc {
+
+#ifdef SNAKE_COUNT_ALLOCATIONS
+    bool enabled() { return true; }
+#else
+    bool enabled() { return false; }
+#endif
+
+    unsigned long long threadCount() { return t_threadCount; }
+    unsigned long long totalCount() { return g_totalCount.load(std::memory_order_relaxed); }
+
+} // namespace utility::alloc
+
+#ifdef SNAKE_COUNT_ALLOCATIONS
+
+// the replaceable global allocation functions, the other forms end up here
+void *operator new(std::size_t size) {
+    t_threadCount++;
+    g_totalCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+#endif
@@ -60,6 +60,30 @@ void AppConfig::setDefaultValue() {
     trainingDataPath = std::string("../config/training");
     latestSaveGeneration = 0;
     latestSaveTimestamp = std::string("");
+    threadNum = 0;
+    threadAffinity = std::string("none");
+    lptScheduling = true;
+    evaluationSliceSteps = 0;
+    inferenceLanes = 0;
+    loopDetection = false;
+    evaluationStages = 0;
+    evaluationStageSteps = 100;
+    evaluationStageKeep = 0.5;
+    evaluationStageAuditFrequency = 0;
+    evaluationSeed = 0;
+    masterSeed = 0;
+    generationBudgetMs = 0;
+    budgetPopulationMin = 0;
+    budgetPopulationMax = 0;
+    budgetStepCapMin = 200;
+    budgetStepCapMax = 0;
+    budgetWanderMin = 0;
+    evaluationGames = 1;
+    evaluationAggregate = std::string("mean");
+    evaluationQuantile = 0.25;
+    steadyState = false;
+    fitnessCache = true;
+    keepElites = false;
 }
 
 void AppConfig::initAppConfig() {
@@ -117,6 +141,30 @@ void AppConfig::saveAppConfig(const std::string &filename) {
     training_node["trainingDataPath"] = this->trainingDataPath;
     training_node["latestSaveGeneration"] = this->latestSaveGeneration;
     training_node["latestSaveTimestamp"] = this->latestSaveTimestamp;
+    training_node["threadNum"] = this->threadNum;
+    training_node["threadAffinity"] = this->threadAffinity;
+    training_node["lptScheduling"] = this->lptScheduling;
+    training_node["evaluationSliceSteps"] = this->evaluationSliceSteps;
+    training_node["inferenceLanes"] = this->inferenceLanes;
+    training_node["loopDetection"] = this->loopDetection;
+    training_node["evaluationStages"] = this->evaluationStages;
+    training_node["evaluationStageSteps"] = this->evaluationStageSteps;
+    training_node["evaluationStageKeep"] = this->evaluationStageKeep;
+    training_node["evaluationStageAuditFrequency"] = this->evaluationStageAuditFrequency;
+    training_node["evaluationSeed"] = this->evaluationSeed;
+    training_node["masterSeed"] = this->masterSeed;
+    training_node["generationBudgetMs"] = this->generationBudgetMs;
+    training_node["budgetPopulationMin"] = this->budgetPopulationMin;
+    training_node["budgetPopulationMax"] = this->budgetPopulationMax;
+    training_node["budgetStepCapMin"] = this->budgetStepCapMin;
+    training_node["budgetStepCapMax"] = this->budgetStepCapMax;
+    training_node["budgetWanderMin"] = this->budgetWanderMin;
+    training_node["evaluationGames"] = this->evaluationGames;
+    training_node["evaluationAggregate"] = this->evaluationAggregate;
+    training_node["evaluationQuantile"] = this->evaluationQuantile;
+    training_node["steadyState"] = this->steadyState;
+    training_node["fitnessCache"] = this->fitnessCache;
+    training_node["keepElites"] = this->keepElites;
 
     json AI_node;
     AI_node["nnFile"] = this->nnFilename;
@@ -198,4 +246,29 @@ void AppConfig::loadAppConfig(const std::string &filename) {
     this->trainingDataPath = training_node["trainingDataPath"];
     this->latestSaveGeneration = training_node["latestSaveGeneration"];
     this->latestSaveTimestamp = training_node["latestSaveTimestamp"];
+    // optional, older config files do not have these
+    this->threadNum = training_node.value("threadNum", 0);
+    this->threadAffinity = training_node.value("threadAffinity", std::string("none"));
+    this->lptScheduling = training_node.value("lptScheduling", true);
+    this->evaluationSliceSteps = training_node.value("evaluationSliceSteps", 0);
+    this->inferenceLanes = training_node.value("inferenceLanes", 0);
+    this->loopDetection = training_node.value("loopDetection", false);
+    this->evaluationStages = training_node.value("evaluationStages", 0);
+    this->evaluationStageSteps = training_node.value("evaluationStageSteps", 100);
+    this->evaluationStageKeep = training_node.value("evaluationStageKeep", 0.5);
+    this->evaluationStageAuditFrequency = training_node.value("evaluationStageAuditFrequency", 0);
+    this->evaluationSeed = training_node.value("evaluationSeed", 0u);
+    this->masterSeed = training_node.value("masterSeed", 0u);
+    this->generationBudgetMs = training_node.value("generationBudgetMs", 0);
+    this->budgetPopulationMin = training_node.value("budgetPopulationMin", 0);
+    this->budgetPopulationMax = training_node.value("budgetPopulationMax", 0);
+    this->budgetStepCapMin = training_node.value("budgetStepCapMin", 200);
+    this->budgetStepCapMax = training_node.value("budgetStepCapMax", 0);
+    this->budgetWanderMin = training_node.value("budgetWanderMin", 0);
+    this->evaluationGames = training_node.value("evaluationGames", 1);
+    this->evaluationAggregate = training_node.value("evaluationAggregate", std::string("mean"));
+    this->evaluationQuantile = training_node.value("evaluationQuantile", 0.25);
+    this->steadyState = training_node.value("steadyState", false);
+    this->fitnessCache = training_node.value("fitnessCache", true);
+    this->keepElites = training_node.value("keepElites", false);
 }
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "Bench/Bench.h"
+
+#include "GameSettings.h"
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Simulation/HeadlessGame.h"
+#include "Simulation/LaneEvaluator.h"
+#include "SnakeApp.h"
+#include "SnakeBrain.h"
+#include "Training/Genome.h"
+#include "SnakeModel.h"
+#include "Utility.h"
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    int alloc() {
+        if (!utility::alloc::enabled()) {
+            // nothing is checked without the counter, that must not pass for zero allocations
+            std::string report("alloc bench: FAILED, the allocation counter is not built in, "
+                               "build the bench_alloc target or configure with -DSNAKE_COUNT_ALLOCATIONS=ON\n");
+            fmt::print(stderr, "{}", report);
+            LOG(ERROR) << report;
+            return 1;
+        }
+
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        const auto settings = GameSettings::capture();
+
+        utility::random::seed(20221104);
+        std::vector<std::unique_ptr<SnakeBrain>> brains;
+        std::vector<unsigned int> seeds;
+        for (int i = 0; i < gameNum; i++) {
+            brains.push_back(std::make_unique<SnakeBrain>());
+            brains.back()->getNeuralNetwork()->setWeightMatricesWithRandomValue();
+            seeds.push_back(utility::random::generateRandomNumber(1, std::numeric_limits<int>::max()));
+        }
+
+        // the same weights as genomes, what the lane evaluator plays from
+        ga::GenomeStore genomes(brains[0]->getNeuralNetwork()->getTopology(), gameNum);
+        for (int i = 0; i < gameNum; i++) {
+            ga::copyFromNetwork(*brains[i]->getNeuralNetwork(), genomes.at(i));
+        }
+
+        std::string report = fmt::format("alloc bench: games = {}, board = {}x{}\n", gameNum, settings->row, settings->col);
+        int failed = 0;
+
+        auto line = [&report](const std::string &name, unsigned long long allocations, long long steps, bool mustBeZero) {
+            report += fmt::format("  {:24}: allocations = {:8}, steps = {:8}, per step = {:.4f}{}\n",
+                                  name, allocations, steps, steps > 0 ? double(allocations) / steps : 0.0,
+                                  mustBeZero ? (allocations == 0 ? " ok" : " FAILED, expect 0") : "");
+        };
+
+        // the training loop of one individual: playGame with SnakeBrain::think
+        {
+            sim::HeadlessGame game(settings->row, settings->col, settings->wanderThreshold);
+            long long steps = 0;
+
+            const unsigned long long before = utility::alloc::threadCount();
+            for (int i = 0; i < gameNum; i++) {
+                game.reset(seeds[i]);
+                sim::playGame(game, *brains[i], 0);
+                steps += game.state().totalSteps;
+            }
+            const unsigned long long allocations = utility::alloc::threadCount() - before;
+
+            line("playGame + think", allocations, steps, true);
+            failed += allocations != 0;
+        }
+
+        // the lane evaluation, the evaluator and its callbacks set up beforehand
+        {
+            sim::LaneEvaluator evaluator(16, settings->row, settings->col, settings->wanderThreshold, *brains[0]->getNeuralNetwork());
+            int nextIndex = 0;
+            long long steps = 0;
+            sim::LaneEvaluator::NextJob next = [&](sim::LaneEvaluator::Job &job) {
+                if (nextIndex >= gameNum) {
+                    return false;
+                }
+                job = sim::LaneEvaluator::Job{nextIndex, genomes.at(nextIndex), seeds[nextIndex]};
+                nextIndex++;
+                return true;
+            };
+            sim::LaneEvaluator::Finished finished = [&](int, const sim::EpisodeResult &result) { steps += result.totalSteps; };
+
+            const unsigned long long before = utility::alloc::threadCount();
+            evaluator.run(next, finished);
+            const unsigned long long allocations = utility::alloc::threadCount() - before;
+
+            line("LaneEvaluator, 16 lanes", allocations, steps, true);
+            failed += allocations != 0;
+        }
+
+        // the generation arena: scratch arrays and log lines of a generation. the first
+        // generation runs past the block, the block grows when the second one starts,
+        // the ones after that must not allocate
+        {
+            const int generationNum = 10;
+            unsigned long long allocations = 0;
+            for (int g = 0; g < generationNum; g++) {
+                utility::memory::resetArena();
+
+                const unsigned long long before = utility::alloc::threadCount();
+                std::pmr::vector<long long> scratch(utility::memory::generationResource());
+                for (int i = 0; i < gameNum * 64; i++) {
+                    scratch.push_back(i);
+                }
+                std::pmr::string result(utility::memory::generationResource());
+                utility::time::measure(utility::memory::format("GA: generation = {} bench", g), result, []() {});
+                if (g > 1) {
+                    allocations += utility::alloc::threadCount() - before;
+                }
+            }
+
+            line("generation arena", allocations, generationNum - 2, true);
+            failed += allocations != 0;
+        }
+
+        // SnakeApp in train mode, reported only: its body deque allocates a block now and then
+        {
+            unsigned long long allocations = 0;
+            long long steps = 0;
+            for (int i = 0; i < std::min(gameNum, 200); i++) {
+                utility::random::seed(seeds[i]);
+                SnakeApp app(settings);
+
+                const unsigned long long before = utility::alloc::threadCount();
+                app.runTrainSlice(0);
+                allocations += utility::alloc::threadCount() - before;
+                steps += app.getSnakeModel()->getTotalStepCount();
+            }
+
+            line("SnakeApp train step", allocations, steps, false);
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return failed == 0 ? 0 : 1;
+    }
+
+} // namespace bench
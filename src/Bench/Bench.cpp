@@ -0,0 +1,46 @@
+#include "Bench/Bench.h"
+
+#include <fmt/core.h>
+#include <functional>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <map>
+
+DEFINE_int32(bench_games, 2000, "games played by a bench");
+DEFINE_int64(bench_seed, 0, "the seed the replay bench plays, 0 = the one saved with the network");
+DEFINE_string(bench_network, "", "the network the replay bench plays, empty = the one in appConfig.json");
+
+namespace bench {
+
+    int run(const std::string &name) {
+        static const std::map<std::string, std::function<int()>> benches{
+            {"alloc", alloc},
+            {"body", body},
+            {"boards", boards},
+            {"dims", dims},
+            {"engine", engine},
+            {"lanes", lanes},
+            {"replay", replay},
+            {"seeds", seeds},
+            {"vecenv", vecEnv},
+            {"vision", vision},
+        };
+
+        auto it = benches.find(name);
+        if (it == benches.end()) {
+            std::string names;
+            for (const auto &b : benches) {
+                names += (names.empty() ? "" : ", ") + b.first;
+            }
+            fmt::print("Unknown bench '{}', available: {}\n", name, names);
+            return 1;
+        }
+
+        LOG(INFO) << "Bench start: " << name;
+        int result = it->second();
+        LOG(INFO) << fmt::format("Bench end: {}, result = {}", name, result);
+
+        return result;
+    }
+
+} // namespace bench
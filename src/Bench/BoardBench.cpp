@@ -0,0 +1,168 @@
+#include "Bench/Bench.h"
+
+#include "Bench/ChasePolicy.h"
+#include "Simulation/Bitboard.h"
+#include "Simulation/HeadlessGame.h"
+#include "Simulation/RayTable.h"
+#include "Simulation/TiledOccupancy.h"
+#include <algorithm>
+#include <chrono>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // the nearest set cell on a ray cell by cell, the reference
+    int walkNearest(const std::vector<uint8_t> &cells, int n, int row, int col, int ray) {
+        int distance = 0;
+        for (int r = row + sim::c_visionRay[ray][0], c = col + sim::c_visionRay[ray][1];
+             r >= 0 && r < n && c >= 0 && c < n;
+             r += sim::c_visionRay[ray][0], c += sim::c_visionRay[ray][1], distance++) {
+            if (cells[r * n + c]) {
+                return distance;
+            }
+        }
+        return -1;
+    }
+
+    // the chase games with the vision built before every move, as in the vision bench
+    template <typename Vision>
+    long long playAll(sim::HeadlessGame &game, int gameNum, Vision &&vision) {
+        long long steps = 0;
+        for (int g = 0; g < gameNum; g++) {
+            std::minstd_rand rng(g + 1);
+            game.reset(g + 1);
+            while (game.isAlive()) {
+                vision(game);
+                game.setDirection(bench::chase(game, rng));
+                game.step();
+                steps++;
+            }
+        }
+        return steps;
+    }
+
+} // namespace
+
+namespace bench {
+
+    int boards() {
+        const int queryNum = std::max(1, FLAGS_bench_games) * 100;
+        const int gameNum = std::max(1, FLAGS_bench_games / 100);
+        int mismatch = 0;
+        std::string report = fmt::format("boards bench: queries = {} per board and density, games = {} per board\n", queryNum, gameNum);
+
+        // nearest body queries on random boards, tiles against the plane rays and the walk
+        for (int n : {10, 16, 32, 64, 128, 256}) {
+            const sim::RayTable &rays = sim::RayTable::get(n, n);
+
+            for (double density : {0.01, 0.1}) {
+                std::minstd_rand rng(n);
+                std::bernoulli_distribution occupied(density);
+                std::vector<uint8_t> cells(n * n, 0);
+                sim::Bitboard plane(n * n);
+                sim::TiledOccupancy tiles(n, n);
+                for (int cell = 0; cell < n * n; cell++) {
+                    if (occupied(rng)) {
+                        cells[cell] = 1;
+                        plane.set(cell);
+                        tiles.set(cell / n, cell % n);
+                    }
+                }
+
+                std::vector<int> queries(queryNum);
+                for (auto &q : queries) {
+                    q = int(rng() % (n * n)) * sim::RayTable::c_rayNum + int(rng() % sim::RayTable::c_rayNum);
+                }
+
+                int boardMismatch = 0;
+                for (int q = 0; q < std::min(queryNum, 100000); q++) {
+                    const int cell = queries[q] / sim::RayTable::c_rayNum, ray = queries[q] % sim::RayTable::c_rayNum;
+                    const int reference = walkNearest(cells, n, cell / n, cell % n, ray);
+                    boardMismatch += rays.nearest(plane, cell, ray) != reference;
+                    boardMismatch += tiles.nearest(cell / n, cell % n, ray) != reference;
+                }
+
+                long long checksum = 0;
+                auto start = Clock::now();
+                for (int q : queries) {
+                    const int cell = q / sim::RayTable::c_rayNum;
+                    checksum += rays.nearest(plane, cell, q % sim::RayTable::c_rayNum);
+                }
+                const double planeNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queryNum;
+
+                start = Clock::now();
+                for (int q : queries) {
+                    const int cell = q / sim::RayTable::c_rayNum;
+                    checksum += tiles.nearest(cell / n, cell % n, q % sim::RayTable::c_rayNum);
+                }
+                const double tiledNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / queryNum;
+
+                report += fmt::format("  nearest {:3}x{:<3} density {:.2f}: mismatches = {}, plane rays = {:6.1f} ns, tiles = {:6.1f} ns ({:.1f}x), checksum = {}\n",
+                                      n, n, density, boardMismatch, planeNs, tiledNs, tiledNs > 0 ? planeNs / tiledNs : 0.0, checksum);
+                mismatch += boardMismatch;
+            }
+        }
+
+        // the games: vision with tiles against the flat plane at every step, then the cost per step of each
+        for (int n : {32, 64, 128, 256}) {
+            sim::HeadlessGame tiled(n, n, n * n - 1);
+            sim::HeadlessGame flat(n, n, n * n - 1);
+            tiled.setTiledOccupancy(true);
+            flat.setTiledOccupancy(false);
+
+            double reference[sim::HeadlessGame::c_visionSize];
+            double vision[sim::HeadlessGame::c_visionSize];
+
+            int boardMismatch = 0;
+            long long steps = 0;
+            for (int g = 0; g < gameNum; g++) {
+                std::minstd_rand rng(g + 1);
+                tiled.reset(g + 1);
+                flat.reset(g + 1);
+                while (tiled.isAlive() && flat.isAlive()) {
+                    tiled.buildVision(vision);
+                    flat.buildVisionByWalk(reference);
+                    boardMismatch += !std::equal(reference, reference + sim::HeadlessGame::c_visionSize, vision);
+                    const int8_t direction = bench::chase(tiled, rng);
+                    tiled.setDirection(direction);
+                    flat.setDirection(direction);
+                    tiled.step();
+                    flat.step();
+                    steps++;
+                }
+                boardMismatch += tiled.isAlive() != flat.isAlive() || tiled.state().score != flat.state().score;
+            }
+
+            double checksum = 0;
+            auto start = Clock::now();
+            playAll(flat, gameNum, [](const sim::HeadlessGame &) {});
+            const double baseMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+            auto visionNs = [&](sim::HeadlessGame &game) {
+                auto begin = Clock::now();
+                playAll(game, gameNum, [&](const sim::HeadlessGame &g) {
+                    g.buildVision(vision);
+                    checksum += vision[1];
+                });
+                const double ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count() - baseMs;
+                return steps > 0 ? ms * 1e6 / steps : 0.0;
+            };
+            const double flatNs = visionNs(flat);
+            const double tiledNs = visionNs(tiled);
+
+            report += fmt::format("  games   {:3}x{:<3}: steps = {:8}, mismatches = {}, step = {:6.1f} ns, vision plane rays = {:6.1f} ns, tiles = {:6.1f} ns, checksum = {:.3g}\n",
+                                  n, n, steps, boardMismatch, steps > 0 ? baseMs * 1e6 / steps : 0.0, flatNs, tiledNs, checksum);
+            mismatch += boardMismatch;
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
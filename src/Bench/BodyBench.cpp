@@ -0,0 +1,298 @@
+#include "Bench/Bench.h"
+
+#include "BlockModel.h"
+#include "Bench/ChasePolicy.h"
+#include "Simulation/ExpiryGrid.h"
+#include "Simulation/HeadlessGame.h"
+#include <chrono>
+#include <deque>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct Move {
+        int cell;
+        bool ate;
+    };
+
+    struct GameRecord {
+        int start;
+        size_t begin;
+        size_t end;
+    };
+
+    // the moves of the chase games, so every body representation replays the same ones
+    struct Recording {
+        std::vector<GameRecord> games;
+        std::vector<Move> moves;
+    };
+
+    Recording record(int n, int gameNum) {
+        Recording rec;
+        sim::HeadlessGame game(n, n, n * n - 1);
+
+        for (int g = 0; g < gameNum; g++) {
+            std::minstd_rand rng(g + 1);
+            game.reset(g + 1);
+
+            GameRecord r{game.state().headRow * n + game.state().headCol, rec.moves.size(), 0};
+            while (game.isAlive()) {
+                game.setDirection(bench::chase(game, rng));
+                sim::StepResult result = game.step();
+                if (result == sim::StepResult::moved || result == sim::StepResult::ate || result == sim::StepResult::perfect) {
+                    rec.moves.push_back({game.state().headRow * n + game.state().headCol, result != sim::StepResult::moved});
+                }
+            }
+            r.end = rec.moves.size();
+            rec.games.push_back(r);
+        }
+        return rec;
+    }
+
+    // SnakeModel: the body queue and the board, written on both ends of a move
+    class DequeBody {
+    public:
+        explicit DequeBody(int n) : m_col(n), m_board(n, std::vector<char>(n, DEFAULT_EMPTY)) {}
+
+        void reset(int head) {
+            for (const auto &b : m_body) {
+                m_board[b.row][b.col] = DEFAULT_EMPTY;
+            }
+            m_body.clear();
+            addHead(head);
+        }
+
+        bool occupied(int cell) const { return m_board[cell / m_col][cell % m_col] == DEFAULT_SNAKE; }
+
+        void move(const Move &m) {
+            if (!m.ate) {
+                const BlockPosition &tail = m_body.back();
+                m_board[tail.row][tail.col] = DEFAULT_EMPTY;
+                m_body.pop_back();
+            }
+            addHead(m.cell);
+        }
+
+        const std::deque<BlockPosition> &body() const { return m_body; }
+        int cellOf(const BlockPosition &b) const { return b.row * m_col + b.col; }
+
+    private:
+        void addHead(int cell) {
+            m_body.push_front(BlockPosition{cell / m_col, cell % m_col});
+            m_board[cell / m_col][cell % m_col] = DEFAULT_SNAKE;
+        }
+
+        int m_col;
+        std::deque<BlockPosition> m_body;
+        std::vector<std::vector<char>> m_board;
+    };
+
+    // HeadlessGame: a ring buffer of cells and a flat cell array
+    class RingBody {
+    public:
+        explicit RingBody(int n) : m_size(n * n), m_cells(n * n, 0), m_body(n * n, 0) {}
+
+        void reset(int head) {
+            for (int i = 0; i < m_length; i++) {
+                m_cells[m_body[(m_head + i) % m_size]] = 0;
+            }
+            m_length = 0;
+            m_head = 0;
+            addHead(head);
+        }
+
+        bool occupied(int cell) const { return m_cells[cell] != 0; }
+
+        void move(const Move &m) {
+            if (!m.ate) {
+                int tail = m_head + m_length - 1;
+                if (tail >= m_size) {
+                    tail -= m_size;
+                }
+                m_cells[m_body[tail]] = 0;
+                m_length--;
+            }
+            addHead(m.cell);
+        }
+
+    private:
+        void addHead(int cell) {
+            m_head = (m_head == 0 ? m_size : m_head) - 1;
+            m_body[m_head] = cell;
+            m_cells[cell] = 1;
+            m_length++;
+        }
+
+        int m_size;
+        int m_head = 0;
+        int m_length = 0;
+        std::vector<uint8_t> m_cells;
+        std::vector<int> m_body;
+    };
+
+    void move(sim::ExpiryGrid &grid, const Move &m) {
+        if (m.ate) {
+            grid.grow(m.cell);
+        } else {
+            grid.forward(m.cell);
+        }
+    }
+
+    // the body check on the target cell, then the move, over every recorded move
+    template <typename Body>
+    double replay(Body &body, const Recording &rec, int rounds, long long &hits) {
+        auto start = bench::Clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (const auto &g : rec.games) {
+                body.reset(g.start);
+                for (size_t i = g.begin; i < g.end; i++) {
+                    const Move &m = rec.moves[i];
+                    hits += body.occupied(m.cell);
+                    body.move(m);
+                }
+            }
+        }
+        return std::chrono::duration<double, std::milli>(bench::Clock::now() - start).count();
+    }
+
+    double replay(sim::ExpiryGrid &grid, const Recording &rec, int rounds, long long &hits) {
+        auto start = bench::Clock::now();
+        for (int round = 0; round < rounds; round++) {
+            for (const auto &g : rec.games) {
+                grid.reset(g.start);
+                for (size_t i = g.begin; i < g.end; i++) {
+                    const Move &m = rec.moves[i];
+                    hits += grid.occupied(m.cell);
+                    move(grid, m);
+                }
+            }
+        }
+        return std::chrono::duration<double, std::milli>(bench::Clock::now() - start).count();
+    }
+
+    // the chase games on the game itself, returns the steps
+    long long playAll(sim::HeadlessGame &game, int gameNum) {
+        long long steps = 0;
+        for (int g = 0; g < gameNum; g++) {
+            std::minstd_rand rng(g + 1);
+            game.reset(g + 1);
+            while (game.isAlive()) {
+                game.setDirection(bench::chase(game, rng));
+                game.step();
+                steps++;
+            }
+        }
+        return steps;
+    }
+
+} // namespace
+
+namespace bench {
+
+    int body() {
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        const int checkGameNum = std::min(gameNum, 200);
+        const int rounds = 5;
+        int mismatch = 0;
+        std::string report = fmt::format("body bench: games = {} per board, checked = {}, rounds = {}\n", gameNum, checkGameNum, rounds);
+
+        for (int n : {10, 20, 32}) {
+            const int cellNum = n * n;
+            Recording rec = record(n, gameNum);
+
+            DequeBody deque(n);
+            RingBody ring(n);
+            sim::ExpiryGrid grid(n, n);
+
+            // same occupancy everywhere after every move, the grid's tail is the
+            // deque's, and each segment frees after as many moves as it is from the tail
+            int boardMismatch = 0;
+            for (int g = 0; g < checkGameNum; g++) {
+                const GameRecord &r = rec.games[g];
+                deque.reset(r.start);
+                ring.reset(r.start);
+                grid.reset(r.start);
+
+                for (size_t i = r.begin; i < r.end; i++) {
+                    deque.move(rec.moves[i]);
+                    ring.move(rec.moves[i]);
+                    move(grid, rec.moves[i]);
+
+                    for (int cell = 0; cell < cellNum; cell++) {
+                        if (deque.occupied(cell) != ring.occupied(cell) || deque.occupied(cell) != grid.occupied(cell)) {
+                            boardMismatch++;
+                        }
+                    }
+
+                    const int length = deque.body().size();
+                    if (length != grid.length() || deque.cellOf(deque.body().back()) != grid.tail()) {
+                        boardMismatch++;
+                    }
+                    for (int s = 0; s < length; s++) {
+                        const int cell = deque.cellOf(deque.body()[s]);
+                        if (grid.freeIn(cell) != length - s || grid.freeBy(cell, length - s - 1)) {
+                            boardMismatch++;
+                        }
+                    }
+                }
+            }
+
+            long long dequeHits = 0, ringHits = 0, gridHits = 0;
+            double dequeMs = replay(deque, rec, rounds, dequeHits);
+            double ringMs = replay(ring, rec, rounds, ringHits);
+            double gridMs = replay(grid, rec, rounds, gridHits);
+            if (dequeHits != ringHits || dequeHits != gridHits) {
+                boardMismatch++;
+            }
+
+            // the games with the ring buffer and with the expiry body, the same games
+            sim::HeadlessGame ringGame(n, n, n * n - 1);
+            sim::HeadlessGame expiryGame(n, n, n * n - 1);
+            expiryGame.setExpiryBody(true);
+            for (int g = 0; g < checkGameNum; g++) {
+                std::minstd_rand rng(g + 1);
+                ringGame.reset(g + 1);
+                expiryGame.reset(g + 1);
+                while (ringGame.isAlive() && expiryGame.isAlive()) {
+                    const int8_t direction = bench::chase(ringGame, rng);
+                    ringGame.setDirection(direction);
+                    expiryGame.setDirection(direction);
+                    ringGame.step();
+                    expiryGame.step();
+                    const sim::GameState &a = ringGame.state(), &b = expiryGame.state();
+                    if (a.headRow != b.headRow || a.headCol != b.headCol || a.length != b.length || a.apple != b.apple || a.last != b.last) {
+                        boardMismatch++;
+                    }
+                }
+                boardMismatch += ringGame.isAlive() != expiryGame.isAlive();
+            }
+
+            auto start = Clock::now();
+            const long long gameSteps = playAll(ringGame, gameNum);
+            const double ringGameMs = elapsedMs(start);
+            start = Clock::now();
+            playAll(expiryGame, gameNum);
+            const double expiryGameMs = elapsedMs(start);
+
+            const double moves = double(rec.moves.size()) * rounds;
+            report += fmt::format("  {:2}x{:<2}: moves = {:9}, mismatches = {}, deque = {:.3f} ms ({:.2f} ns/move), "
+                                  "ring = {:.3f} ms ({:.1f}x), expiry = {:.3f} ms ({:.1f}x), hits = {}\n"
+                                  "         game steps = {:9}, ring body = {:.3f} ms, expiry body = {:.3f} ms ({:.2f}x)\n",
+                                  n, n, rec.moves.size(), boardMismatch, dequeMs, dequeMs * 1e6 / moves,
+                                  ringMs, ringMs > 0 ? dequeMs / ringMs : 0.0,
+                                  gridMs, gridMs > 0 ? dequeMs / gridMs : 0.0, dequeHits,
+                                  gameSteps, ringGameMs, expiryGameMs, expiryGameMs > 0 ? ringGameMs / expiryGameMs : 0.0);
+            mismatch += boardMismatch;
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
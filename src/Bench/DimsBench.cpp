@@ -0,0 +1,98 @@
+#include "Bench/Bench.h"
+
+#include "Bench/ChasePolicy.h"
+#include "Simulation/HeadlessGame.h"
+#include <algorithm>
+#include <chrono>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace {
+
+    // the chase games with the network input built before every move, like a
+    // training game without the network. the result of every game is appended to results.
+    template <typename Game>
+    long long playAll(Game &game, int gameNum, std::vector<sim::GameState> &results, double &checksum) {
+        double input[Game::c_inputSize];
+        long long steps = 0;
+
+        for (int g = 0; g < gameNum; g++) {
+            std::minstd_rand rng(g + 1);
+            game.reset(g + 1);
+            while (game.isAlive()) {
+                game.buildInput(input);
+                checksum += input[0];
+                game.setDirection(bench::chase(game, rng));
+                game.step();
+                steps++;
+            }
+            results.push_back(game.state());
+        }
+        return steps;
+    }
+
+    bool sameGame(const sim::GameState &a, const sim::GameState &b) {
+        return a.score == b.score && a.totalSteps == b.totalSteps && a.eatSteps == b.eatSteps &&
+               a.headRow == b.headRow && a.headCol == b.headCol && a.apple == b.apple && a.last == b.last;
+    }
+
+} // namespace
+
+namespace bench {
+
+    int dims() {
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        const int rounds = 5;
+        int mismatch = 0;
+        std::string report = fmt::format("dims bench: games = {} per board, best of {} rounds\n", gameNum, rounds);
+
+        for (int n : {10, 16, 20, 24, 32}) {
+            sim::HeadlessGame fixed(n, n, n * n - 1);
+            sim::HeadlessGame dynamic(n, n, n * n - 1, false);
+
+            double fixedMs = 0, dynamicMs = 0, checksum = 0;
+            long long steps = 0;
+            std::vector<sim::GameState> fixedResults, dynamicResults;
+
+            // one dispatch per pass, the games run on the typed engine. the two
+            // take turns and the fastest round of each counts, the machine's noise
+            // is about as large as the difference
+            for (int round = 0; round < rounds; round++) {
+                fixedResults.clear();
+                dynamicResults.clear();
+
+                auto start = Clock::now();
+                std::visit([&](auto &g) { steps = playAll(sim::unbox(g), gameNum, fixedResults, checksum); }, fixed.variant());
+                const double ms = elapsedMs(start);
+                fixedMs = round == 0 ? ms : std::min(fixedMs, ms);
+
+                start = Clock::now();
+                std::visit([&](auto &g) { playAll(sim::unbox(g), gameNum, dynamicResults, checksum); }, dynamic.variant());
+                const double dynamicRoundMs = elapsedMs(start);
+                dynamicMs = round == 0 ? dynamicRoundMs : std::min(dynamicMs, dynamicRoundMs);
+            }
+
+            int boardMismatch = 0;
+            for (int g = 0; g < gameNum; g++) {
+                if (!sameGame(fixedResults[g], dynamicResults[g])) {
+                    boardMismatch++;
+                }
+            }
+
+            report += fmt::format("  {:2}x{:<2}: steps = {:9}, mismatches = {}, {} = {:.3f} ms, dynamic = {:.3f} ms ({:.2f}x), checksum = {:.3g}\n",
+                                  n, n, steps, boardMismatch, fixed.isFixed() ? "fixed" : "dynamic", fixedMs, dynamicMs,
+                                  fixedMs > 0 ? dynamicMs / fixedMs : 0.0, checksum);
+            mismatch += boardMismatch;
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
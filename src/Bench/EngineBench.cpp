@@ -0,0 +1,170 @@
+#include "Bench/Bench.h"
+
+#include "AppConfig.h"
+#include "GameSettings.h"
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Simulation/HeadlessGame.h"
+#include "SnakeApp.h"
+#include "SnakeModel.h"
+#include "Utility.h"
+#include <chrono>
+#include <filesystem>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <random>
+
+namespace {
+
+    void copyWeights(NeuralNetwork &from, NeuralNetwork &to) {
+        int weightMatrixNum = to.getTopology().size() - 1;
+        for (int w = 0; w < weightMatrixNum; w++) {
+            auto src = from.weightMatrixAt(w);
+            auto dst = to.weightMatrixAt(w);
+            for (int i = 0; i < dst->getRowNum(); i++) {
+                for (int j = 0; j < dst->getColNum(); j++) {
+                    dst->setValue(i, j, src->getValue(i, j));
+                }
+            }
+        }
+    }
+
+    void randomWeights(NeuralNetwork &nn, std::mt19937 &rng) {
+        std::uniform_real_distribution<double> dist(-1, 1);
+        int weightMatrixNum = nn.getTopology().size() - 1;
+        for (int w = 0; w < weightMatrixNum; w++) {
+            auto m = nn.weightMatrixAt(w);
+            for (int i = 0; i < m->getRowNum(); i++) {
+                for (int j = 0; j < m->getColNum(); j++) {
+                    m->setValue(i, j, dist(rng));
+                }
+            }
+        }
+    }
+
+} // namespace
+
+namespace bench {
+
+    int engine() {
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        const int replayRounds = 10;
+        const auto settings = GameSettings::capture();
+
+        // the trained network plays long games, random weights cover the early deaths
+        std::shared_ptr<NeuralNetwork> trained = nullptr;
+        if (std::filesystem::exists(AppConfig::NeuralNetworkFilename())) {
+            trained = std::make_shared<NeuralNetwork>(AppConfig::NeuralNetworkFilename());
+            if (trained->getTopology() != settings->topology) {
+                trained = nullptr;
+            }
+        }
+
+        sim::HeadlessGame game(settings->row, settings->col, settings->wanderThreshold);
+        sim::HeadlessGame loopGame(settings->row, settings->col, settings->wanderThreshold);
+        loopGame.setLoopDetection(true);
+        std::mt19937 weightRng(20221104);
+
+        double appMs = 0, engineMs = 0, loopMs = 0;
+        long long steps = 0, apples = 0;
+        int mismatch = 0, trainedGames = 0, maxScore = 0, loopKills = 0;
+        std::vector<std::vector<int8_t>> moves(gameNum);
+        std::vector<double> input(sim::HeadlessGame::c_inputSize);
+
+        for (int g = 0; g < gameNum; g++) {
+            const unsigned int seed = g + 1;
+
+            // SnakeApp draws the snake and the first apple while constructing
+            utility::random::seed(seed);
+            SnakeApp app(settings);
+            auto snake = app.getSnakeModel();
+            auto brain = snake->getBrain();
+            if (trained && 0 == g % 2) {
+                copyWeights(*trained, *brain->getNeuralNetwork());
+                trainedGames++;
+            } else {
+                randomWeights(*brain->getNeuralNetwork(), weightRng);
+            }
+
+            auto start = Clock::now();
+            app.runTrainSlice(0);
+            appMs += elapsedMs(start);
+
+            start = Clock::now();
+            game.reset(seed);
+            sim::playGame(game, *brain, 0);
+            engineMs += elapsedMs(start);
+
+            const sim::GameState &s = game.state();
+            BlockPosition apple = app.getPlayboardModel()->getApplePosition();
+            bool same = s.score == snake->getScore() &&
+                        s.totalSteps == snake->getTotalStepCount() &&
+                        (s.last == sim::StepResult::perfect || s.apple == apple.row * game.getCol() + apple.col);
+
+            // ended at the first repeat, scored as the wander death it leads to
+            start = Clock::now();
+            loopGame.reset(seed);
+            sim::playGame(loopGame, *brain, 0);
+            loopMs += elapsedMs(start);
+
+            const sim::GameState &l = loopGame.state();
+            same = same && l.score == s.score && l.totalSteps == s.totalSteps && l.eatSteps == s.eatSteps;
+            same = same && (l.last == s.last || (l.last == sim::StepResult::looped && s.last == sim::StepResult::wandered));
+            loopKills += l.last == sim::StepResult::looped;
+
+            // the moves again, for timing the engine without the network
+            game.reset(seed);
+            while (game.step(), game.isAlive()) {
+                game.buildInput(input.data());
+                SnakeDirection next = brain->think(input);
+                if (next != SnakeDirection::invalid) {
+                    game.setDirection(next.rawValue());
+                }
+                moves[g].push_back(game.state().direction);
+            }
+            same = same && game.state().totalSteps == s.totalSteps;
+
+            if (!same) {
+                mismatch++;
+                LOG(ERROR) << fmt::format("engine bench mismatch, game = {}, SnakeApp score = {} steps = {} apple = {{{}, {}}}, headless score = {} steps = {} apple = {} result = {}",
+                                          g, snake->getScore(), snake->getTotalStepCount(), apple.row, apple.col,
+                                          s.score, s.totalSteps, s.apple, int(s.last));
+            }
+
+            steps += s.totalSteps;
+            apples += s.score;
+            maxScore = std::max(maxScore, s.score);
+        }
+
+        auto start = Clock::now();
+        long long replaySteps = 0;
+        for (int round = 0; round < replayRounds; round++) {
+            for (int g = 0; g < gameNum; g++) {
+                game.reset(g + 1);
+                for (int8_t d : moves[g]) {
+                    game.step();
+                    game.setDirection(d);
+                }
+                game.step();
+                replaySteps += game.state().totalSteps;
+            }
+        }
+        double replayMs = elapsedMs(start);
+
+        std::string report = fmt::format("engine bench: games = {} ({} trained), steps = {}, apples = {}, max score = {}, board = {}x{}, mismatches = {}\n"
+                                         "  SnakeApp          : {}\n"
+                                         "  headless + brain  : {} ({:.1f}x), input + network = {:.0f}% of it\n"
+                                         "  loop detection    : {} ({:.1f}x), loop kills = {}\n"
+                                         "  headless step only: {} ({:.1f}x)\n",
+                                         gameNum, trainedGames, steps, apples, maxScore, game.getRow(), game.getCol(), mismatch,
+                                         rate(steps, appMs),
+                                         rate(steps, engineMs), engineMs > 0 ? appMs / engineMs : 0.0,
+                                         engineMs > 0 ? std::max(0.0, 100.0 * (1.0 - replayMs / replayRounds / engineMs)) : 0.0,
+                                         rate(steps, loopMs), loopMs > 0 ? appMs / loopMs : 0.0, loopKills,
+                                         rate(replaySteps, replayMs), replayMs > 0 ? appMs / (replayMs / replayRounds) : 0.0);
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
@@ -0,0 +1,185 @@
+#include "Bench/Bench.h"
+
+#include "GameSettings.h"
+#include "NeuralNetwork/LaneNetwork.h"
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Simulation/HeadlessGame.h"
+#include "Simulation/LaneEvaluator.h"
+#include "Simulation/VecEnv.h"
+#include "SnakeBrain.h"
+#include "Training/Genome.h"
+#include "Utility.h"
+#include <chrono>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    int lanes() {
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        const auto settings = GameSettings::capture();
+        const int row = settings->row;
+        const int col = settings->col;
+
+        // a population of random networks, one game each
+        utility::random::seed(20221104);
+        std::vector<std::unique_ptr<SnakeBrain>> brains;
+        std::vector<unsigned int> seeds;
+        for (int i = 0; i < gameNum; i++) {
+            brains.push_back(std::make_unique<SnakeBrain>());
+            brains.back()->getNeuralNetwork()->setWeightMatricesWithRandomValue();
+            seeds.push_back(utility::random::generateRandomNumber(1, std::numeric_limits<int>::max()));
+        }
+
+        // the same weights as genomes, what the lane evaluator plays from
+        ga::GenomeStore genomes(brains[0]->getNeuralNetwork()->getTopology(), gameNum);
+        for (int i = 0; i < gameNum; i++) {
+            ga::copyFromNetwork(*brains[i]->getNeuralNetwork(), genomes.at(i));
+        }
+        const std::vector<int> topology = brains[0]->getNeuralNetwork()->getTopology();
+        const int outputSize = topology.back();
+
+        std::string report = fmt::format("lanes bench: individuals = {}, board = {}x{}\n", gameNum, row, col);
+        int mismatch = 0;
+
+        for (int laneNum : {4, 8, 16, 32}) {
+            if (laneNum > gameNum) {
+                break;
+            }
+
+            // forward pass of laneNum networks on real inputs, against feedForward of each
+            sim::VecEnv env(laneNum, row, col, settings->wanderThreshold, 1);
+            LaneNetwork net(topology, laneNum);
+            for (int l = 0; l < laneNum; l++) {
+                net.setLane(l, *brains[l]->getNeuralNetwork());
+            }
+
+            std::vector<double> inputs(laneNum * sim::VecEnv::c_inputSize);
+            std::vector<double> outputs(laneNum * outputSize);
+            std::vector<int8_t> directions(laneNum);
+            int outputMismatch = 0;
+            for (int s = 0; s < 20; s++) {
+                env.buildInputs(inputs.data());
+                net.forward(inputs.data(), outputs.data());
+
+                for (int l = 0; l < laneNum; l++) {
+                    auto nn = brains[l]->getNeuralNetwork();
+                    nn->setInput(std::vector<double>(inputs.begin() + l * sim::VecEnv::c_inputSize, inputs.begin() + (l + 1) * sim::VecEnv::c_inputSize));
+                    nn->feedForward();
+                    auto expected = nn->activatedValVectorOfLayerAt(topology.size() - 1);
+                    if (!std::equal(expected->begin(), expected->end(), outputs.begin() + l * outputSize)) {
+                        outputMismatch++;
+                    }
+                    directions[l] = SnakeBrain::directionOf(&outputs[l * outputSize], outputSize).rawValue();
+                }
+                env.step(directions.data());
+            }
+
+            const int forwardRounds = std::max(1, 20000 / laneNum);
+            auto start = Clock::now();
+            for (int r = 0; r < forwardRounds; r++) {
+                for (int l = 0; l < laneNum; l++) {
+                    auto &nn = *brains[l]->getNeuralNetwork();
+                    nn.setInput(std::vector<double>(inputs.begin() + l * sim::VecEnv::c_inputSize, inputs.begin() + (l + 1) * sim::VecEnv::c_inputSize));
+                    nn.feedForward();
+                }
+            }
+            const double feedForwardMs = elapsedMs(start);
+
+            start = Clock::now();
+            for (int r = 0; r < forwardRounds; r++) {
+                net.forward(inputs.data(), outputs.data());
+            }
+            const double laneForwardMs = elapsedMs(start);
+            const long long forwards = (long long)forwardRounds * laneNum;
+
+            // the whole population: lockstep games with lane refill against playGame one by one
+            std::vector<sim::EpisodeResult> results(gameNum);
+            sim::LaneEvaluator evaluator(laneNum, row, col, settings->wanderThreshold, *brains[0]->getNeuralNetwork());
+            int nextIndex = 0;
+            start = Clock::now();
+            evaluator.run(
+                [&](sim::LaneEvaluator::Job &job) {
+                    if (nextIndex >= gameNum) {
+                        return false;
+                    }
+                    job = sim::LaneEvaluator::Job{nextIndex, genomes.at(nextIndex), seeds[nextIndex]};
+                    nextIndex++;
+                    return true;
+                },
+                [&](int index, const sim::EpisodeResult &result) { results[index] = result; });
+            const double laneMs = elapsedMs(start);
+
+            sim::HeadlessGame game(row, col, settings->wanderThreshold);
+            long long gameSteps = 0;
+            int episodeMismatch = 0;
+            start = Clock::now();
+            for (int i = 0; i < gameNum; i++) {
+                game.reset(seeds[i]);
+                sim::playGame(game, *brains[i], 0);
+
+                const sim::GameState &s = game.state();
+                const sim::EpisodeResult &e = results[i];
+                gameSteps += s.totalSteps;
+                if (s.score != e.score || s.totalSteps != e.totalSteps || s.eatSteps != e.eatSteps || s.last != e.end) {
+                    episodeMismatch++;
+                }
+            }
+            const double gameMs = elapsedMs(start);
+
+            report += fmt::format("  lanes = {:2}: forward mismatches = {}, episode mismatches = {}\n", laneNum, outputMismatch, episodeMismatch);
+            report += fmt::format("    feedForward per network: {:10.3f} ms, {:12.0f} forwards/s\n", feedForwardMs, forwards * 1000.0 / std::max(feedForwardMs, 1e-9));
+            report += fmt::format("    LaneNetwork            : {:10.3f} ms, {:12.0f} forwards/s ({:.1f}x)\n", laneForwardMs, forwards * 1000.0 / std::max(laneForwardMs, 1e-9),
+                                  laneForwardMs > 0 ? feedForwardMs / laneForwardMs : 0.0);
+            report += fmt::format("    playGame + think       : {}\n", rate(gameSteps, gameMs));
+            report += fmt::format("    LaneEvaluator          : {} ({:.1f}x)\n", rate(gameSteps, laneMs), laneMs > 0 && gameMs > 0 ? gameMs / laneMs : 0.0);
+            mismatch += outputMismatch + episodeMismatch;
+        }
+
+        // with loop detection the lanes must end the same games at the same repeat
+        {
+            std::vector<sim::EpisodeResult> results(gameNum);
+            sim::LaneEvaluator evaluator(std::min(16, gameNum), row, col, settings->wanderThreshold, *brains[0]->getNeuralNetwork());
+            evaluator.setLoopDetection(true);
+            int nextIndex = 0;
+            evaluator.run(
+                [&](sim::LaneEvaluator::Job &job) {
+                    if (nextIndex >= gameNum) {
+                        return false;
+                    }
+                    job = sim::LaneEvaluator::Job{nextIndex, genomes.at(nextIndex), seeds[nextIndex]};
+                    nextIndex++;
+                    return true;
+                },
+                [&](int index, const sim::EpisodeResult &result) { results[index] = result; });
+
+            sim::HeadlessGame game(row, col, settings->wanderThreshold);
+            game.setLoopDetection(true);
+            int episodeMismatch = 0, loopKills = 0;
+            for (int i = 0; i < gameNum; i++) {
+                game.reset(seeds[i]);
+                sim::playGame(game, *brains[i], 0);
+
+                const sim::GameState &s = game.state();
+                const sim::EpisodeResult &e = results[i];
+                if (s.score != e.score || s.totalSteps != e.totalSteps || s.eatSteps != e.eatSteps || s.last != e.end) {
+                    episodeMismatch++;
+                }
+                loopKills += s.last == sim::StepResult::looped;
+            }
+
+            report += fmt::format("  loop detection, lanes = {:2}: episode mismatches = {}, loop kills = {}\n", evaluator.laneNum(), episodeMismatch, loopKills);
+            mismatch += episodeMismatch;
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
@@ -0,0 +1,207 @@
+#include "Bench/Bench.h"
+
+#include "AppConfig.h"
+#include "GameSettings.h"
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Simulation/HeadlessGame.h"
+#include "SnakeApp.h"
+#include "SnakeBrain.h"
+#include "SnakeModel.h"
+#include "TrainApp.h"
+#include "Training/Genome.h"
+#include "Utility.h"
+#include <cstdint>
+#include <filesystem>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+    // the game as it went: every direction the snake moved in, hashed
+    struct Replay {
+        sim::GameState state;
+        uint64_t movesHash;
+    };
+
+    Replay play(sim::HeadlessGame &game, SnakeBrain &brain, unsigned int seed) {
+        std::vector<double> input(sim::HeadlessGame::c_inputSize);
+        uint64_t hash = 0xcbf29ce484222325ULL; /* FNV-1a */
+
+        // playGame move by move
+        game.reset(seed);
+        while (game.step(), game.isAlive()) {
+            game.buildInput(input.data());
+            SnakeDirection next = brain.think(input);
+            if (next != SnakeDirection::invalid) {
+                game.setDirection(next.rawValue());
+            }
+            hash = (hash ^ uint8_t(game.state().direction)) * 0x100000001b3ULL;
+        }
+
+        return Replay{game.state(), hash};
+    }
+
+    // the stream keys of a run from generation 0 until its save, then those of a
+    // restore from the save, each in either mode: a key handed out twice repeats
+    // the numbers drawn from it
+    int streamKeyRepeats(std::string &report) {
+        using Stream = TrainApp::RandomStream;
+        const int population = 64, saveGeneration = 8, restoredGenerations = 8;
+        const int lanes = 16; /* steady state children still playing when the save is written */
+
+        std::unordered_set<uint64_t> keys;
+        int repeats = 0;
+        long long handedOut = 0;
+        auto handOut = [&](Stream stream, int generation, long long index) {
+            repeats += !keys.insert(TrainApp::streamKey(stream, generation, index)).second;
+            handedOut++;
+        };
+        auto breed = [&](int generation) {
+            for (int i = 0; i < population; i++) {
+                handOut(Stream::crossover, generation, i);
+                handOut(Stream::mutate, generation, i);
+            }
+        };
+        // the games of every generation from first to last, the breeding of all but the last
+        auto generational = [&](int first, int last) {
+            for (int g = first; g <= last; g++) {
+                handOut(Stream::gameSeeds, g, 0);
+                if (g < last) {
+                    breed(g);
+                }
+            }
+        };
+        // the first generation's games, then children numbered from 0
+        auto steadyState = [&](int first, long long children) {
+            handOut(Stream::gameSeeds, first, 0);
+            for (long long c = 0; c < children; c++) {
+                handOut(Stream::steadyCrossover, first, c);
+                handOut(Stream::steadyMutate, first, c);
+                handOut(Stream::steadyGameSeeds, first, c);
+            }
+        };
+
+        // the save comes before the saved generation breeds, the restore breeds it
+        // and plays on from the next generation
+        for (bool steadyRun : {false, true}) {
+            for (bool steadyRestore : {false, true}) {
+                keys.clear();
+                for (int i = 0; i < population; i++) {
+                    handOut(Stream::initialWeights, 0, i);
+                }
+                if (steadyRun) {
+                    steadyState(0, (long long)saveGeneration * population + lanes);
+                } else {
+                    generational(0, saveGeneration);
+                }
+
+                breed(saveGeneration);
+                if (steadyRestore) {
+                    steadyState(saveGeneration + 1, (long long)restoredGenerations * population);
+                } else {
+                    generational(saveGeneration + 1, saveGeneration + restoredGenerations);
+                }
+            }
+        }
+        const long long runKeys = handedOut;
+
+        // indexes past 28 and 32 bits stay apart from the stream and from the small ones
+        keys.clear();
+        for (long long high : {0LL, 1LL << 28, 1LL << 32, 1LL << 40}) {
+            for (int i = 0; i < population; i++) {
+                handOut(Stream::crossover, 0, high + i);
+                handOut(Stream::mutate, 0, high + i);
+                handOut(Stream::steadyCrossover, 0, high + i);
+                handOut(Stream::steadyMutate, 0, high + i);
+            }
+        }
+
+        report += fmt::format("  stream keys: {} of runs and their restores in either mode, {} with large indexes, repeats = {}\n",
+                              runKeys, handedOut - runKeys, repeats);
+        return repeats;
+    }
+
+} // namespace
+
+namespace bench {
+
+    int replay() {
+        // the stream keys need no network
+        std::string keyReport;
+        const int repeats = streamKeyRepeats(keyReport);
+        fmt::print("replay bench:\n{}", keyReport);
+        LOG(INFO) << keyReport;
+        if (repeats != 0) {
+            return 1;
+        }
+
+        const auto settings = GameSettings::capture();
+        const std::string filename = FLAGS_bench_network.empty() ? AppConfig::NeuralNetworkFilename() : FLAGS_bench_network;
+
+        if (!std::filesystem::exists(filename)) {
+            fmt::print("replay bench: network {} not found\n", filename);
+            return 1;
+        }
+        NeuralNetwork network(filename);
+        if (network.getTopology() != settings->topology) {
+            fmt::print("replay bench: network {} does not have the training topology\n", filename);
+            return 1;
+        }
+
+        // the seed saved with a training result unless one is given
+        const json &description = network.getDescription();
+        const unsigned int seed = FLAGS_bench_seed != 0 ? unsigned(FLAGS_bench_seed) : description.value("seed", 0u);
+        if (seed == 0) {
+            fmt::print("replay bench: no seed, give one with -bench_seed\n");
+            return 1;
+        }
+
+        std::vector<double> genome(ga::genomeSize(settings->topology));
+        ga::copyFromNetwork(network, genome.data());
+        SnakeBrain brain;
+        ga::copyToNetwork(genome.data(), *brain.getNeuralNetwork());
+
+        // twice with the training rules, and once more on a fresh game
+        sim::HeadlessGame game(settings->row, settings->col, settings->wanderThreshold);
+        game.setLoopDetection(AppConfig::LoopDetection());
+        Replay first = play(game, brain, seed);
+        Replay second = play(game, brain, seed);
+        sim::HeadlessGame freshGame(settings->row, settings->col, settings->wanderThreshold);
+        freshGame.setLoopDetection(AppConfig::LoopDetection());
+        Replay fresh = play(freshGame, brain, seed);
+
+        auto same = [](const Replay &a, const Replay &b) {
+            return a.movesHash == b.movesHash && a.state.score == b.state.score && a.state.totalSteps == b.state.totalSteps &&
+                   a.state.eatSteps == b.state.eatSteps && a.state.last == b.state.last;
+        };
+        int mismatch = !same(first, second) + !same(first, fresh);
+
+        // the game SnakeApp plays from the seed, a loop it plays until it wanders off
+        utility::random::seed(seed);
+        SnakeApp app(settings);
+        ga::copyToNetwork(genome.data(), *app.getSnakeModel()->getBrain()->getNeuralNetwork());
+        app.runTrainSlice(0);
+        auto snake = app.getSnakeModel();
+        mismatch += snake->getScore() != first.state.score || snake->getTotalStepCount() != first.state.totalSteps;
+
+        std::string report = fmt::format("replay bench: network = {}, seed = {}, board = {}x{}\n", filename, seed, settings->row, settings->col);
+        report += fmt::format("  replay  : score = {}, steps = {}, eat steps = {}, end = {}, moves hash = {:016x}\n",
+                              first.state.score, first.state.totalSteps, first.state.eatSteps, int(first.state.last), first.movesHash);
+        report += fmt::format("  SnakeApp: score = {}, steps = {}\n", snake->getScore(), snake->getTotalStepCount());
+        if (description.contains("score") && FLAGS_bench_seed == 0) {
+            // a score of several games is their mean, a culled game's one its score when it was stopped
+            report += fmt::format("  recorded: score = {}, steps = {}, games = {}\n",
+                                  description.value("score", 0), description.value("stepCount", 0), description.value("games", 1));
+        }
+        report += fmt::format("  mismatches = {}\n", mismatch);
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
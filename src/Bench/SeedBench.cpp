@@ -0,0 +1,172 @@
+#include "Bench/Bench.h"
+
+#include "Bench/ChasePolicy.h"
+#include "GameSettings.h"
+#include "Simulation/Fitness.h"
+#include "Simulation/HeadlessGame.h"
+#include "Utility.h"
+#include <algorithm>
+#include <cmath>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // 0 based ranks by descending value, ties share their mean rank
+    std::vector<double> rankOf(const std::vector<long double> &values) {
+        const int n = values.size();
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&values](int a, int b) { return values[a] > values[b]; });
+
+        std::vector<double> ranks(n);
+        for (int first = 0, last = 0; first < n; first = last) {
+            while (last < n && values[order[last]] == values[order[first]]) {
+                last++;
+            }
+            for (int k = first; k < last; k++) {
+                ranks[order[k]] = (first + last - 1) / 2.0;
+            }
+        }
+        return ranks;
+    }
+
+    double spearman(const std::vector<long double> &a, const std::vector<long double> &b) {
+        auto ra = rankOf(a);
+        auto rb = rankOf(b);
+        const int n = ra.size();
+        const double mean = (n - 1) / 2.0;
+
+        double cov = 0, va = 0, vb = 0;
+        for (int i = 0; i < n; i++) {
+            cov += (ra[i] - mean) * (rb[i] - mean);
+            va += (ra[i] - mean) * (ra[i] - mean);
+            vb += (rb[i] - mean) * (rb[i] - mean);
+        }
+        return va > 0 && vb > 0 ? cov / std::sqrt(va * vb) : 1.0;
+    }
+
+    std::vector<unsigned int> drawSeeds(int n) {
+        std::vector<unsigned int> seeds(n);
+        for (auto &seed : seeds) {
+            seed = utility::random::generateRandomNumber(1, std::numeric_limits<int>::max());
+        }
+        return seeds;
+    }
+
+} // namespace
+
+namespace bench {
+
+    int seeds() {
+        const auto settings = GameSettings::capture();
+        const int networkNum = std::max(2, FLAGS_bench_games / 10);
+
+        std::string report = fmt::format("seeds bench: networks = {}, board = {}x{}\n", networkNum, settings->row, settings->col);
+        int mismatch = 0;
+
+        // the aggregates on known values
+        {
+            long double values[] = {3, 1, 2, 5};
+            const int n = 4;
+            mismatch += sim::aggregateFitness(values, n, sim::FitnessAggregate::mean, 0) != 2.75L;
+            mismatch += sim::aggregateFitness(values, n, sim::FitnessAggregate::min, 0) != 1;
+            mismatch += sim::aggregateFitness(values, n, sim::FitnessAggregate::quantile, 0) != 1;
+            mismatch += sim::aggregateFitness(values, n, sim::FitnessAggregate::quantile, 1) != 5;
+            mismatch += sim::aggregateFitness(values, n, sim::FitnessAggregate::quantile, 0.5) != 3;
+            report += fmt::format("  aggregates: mismatches = {}\n", mismatch);
+        }
+
+        // a population whose order is known: chase policies from one random turn in
+        // 2 moves to one in 64, evenly on a log scale. a game follows from the policy and its seed alone, the
+        // random turns come from the seed too, so a shared seed is the same game setup
+        // and the same draws in the same order for every individual
+        std::vector<long double> skill(networkNum);
+        std::vector<int> turnOdds(networkNum);
+        for (int i = 0; i < networkNum; i++) {
+            turnOdds[i] = int(std::lround(2 * std::pow(32.0, double(i) / (networkNum - 1))));
+            skill[i] = turnOdds[i];
+        }
+        report += fmt::format("  population: chase policies, a random turn in 2 to 64 moves\n");
+
+        sim::HeadlessGame game(settings->row, settings->col, settings->wanderThreshold);
+        auto play = [&](int i, unsigned int seed) {
+            std::minstd_rand rng(seed);
+            game.reset(seed);
+            while (game.isAlive()) {
+                game.setDirection(bench::chase(game, rng, turnOdds[i]));
+                game.step();
+            }
+            return sim::fitness(game.state().score, game.state().totalSteps);
+        };
+
+        // a shared seed is the same game every time it is played
+        {
+            int replayMismatch = 0;
+            for (int i = 0; i < networkNum; i++) {
+                const unsigned int seed = 1 + i;
+                replayMismatch += play(i, seed) != play(i, seed);
+            }
+            mismatch += replayMismatch;
+            report += fmt::format("  same seed twice: mismatches = {}\n", replayMismatch);
+        }
+
+        // the population ranked twice, on two seed sets of k games: the closer the
+        // two rankings, the less the ranking depends on the seeds it was played on.
+        // shared: every individual plays the same seeds in the same order. own: every
+        // individual its own. the first ranking is also held against the known order
+        auto rankTrial = [&](int k, bool shared, sim::FitnessAggregate aggregate, double &truth) {
+            std::vector<long double> fitness[2];
+            std::vector<long double> values(k);
+            for (auto &ranking : fitness) {
+                std::vector<unsigned int> seeds = drawSeeds(k);
+                for (int i = 0; i < networkNum; i++) {
+                    if (!shared) {
+                        seeds = drawSeeds(k);
+                    }
+                    for (int g = 0; g < k; g++) {
+                        values[g] = play(i, seeds[g]);
+                    }
+                    ranking.push_back(sim::aggregateFitness(values.data(), k, aggregate, 0.25));
+                }
+            }
+            truth = spearman(fitness[0], skill);
+            return spearman(fitness[0], fitness[1]);
+        };
+
+        // the mean of several trials, one pair of seed sets says little
+        const int trials = 16;
+        utility::random::seed(20221104);
+        auto rankAgreement = [&](int k, bool shared, sim::FitnessAggregate aggregate, double &truth) {
+            double agreement = 0;
+            truth = 0;
+            for (int t = 0; t < trials; t++) {
+                double trialTruth = 0;
+                agreement += rankTrial(k, shared, aggregate, trialTruth) / trials;
+                truth += trialTruth / trials;
+            }
+            return agreement;
+        };
+
+        for (int k : {1, 2, 4, 8}) {
+            double sharedTruth = 0, ownTruth = 0, minTruth = 0, quantileTruth = 0;
+            const double sharedMean = rankAgreement(k, true, sim::FitnessAggregate::mean, sharedTruth);
+            const double ownMean = rankAgreement(k, false, sim::FitnessAggregate::mean, ownTruth);
+            const double sharedMin = rankAgreement(k, true, sim::FitnessAggregate::min, minTruth);
+            const double sharedQuantile = rankAgreement(k, true, sim::FitnessAggregate::quantile, quantileTruth);
+            report += fmt::format("  games = {}: rank agreement of two seed sets / with the known order, shared mean = {:.3f} / {:.3f}, own mean = {:.3f} / {:.3f}, shared min = {:.3f} / {:.3f}, shared quantile 0.25 = {:.3f} / {:.3f}\n",
+                                  k, sharedMean, sharedTruth, ownMean, ownTruth, sharedMin, minTruth, sharedQuantile, quantileTruth);
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
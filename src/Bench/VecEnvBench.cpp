@@ -0,0 +1,122 @@
+#include "Bench/Bench.h"
+
+#include "GameSettings.h"
+#include "NeuralNetwork/BatchNetwork.h"
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Simulation/HeadlessGame.h"
+#include "Simulation/VecEnv.h"
+#include "SnakeBrain.h"
+#include "Utility.h"
+#include <chrono>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    int vecEnv() {
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        const auto settings = GameSettings::capture();
+        const int row = settings->row;
+        const int col = settings->col;
+
+        // one random network drives every game
+        utility::random::seed(20221104);
+        SnakeBrain brain;
+        brain.getNeuralNetwork()->setWeightMatricesWithRandomValue();
+        BatchNetwork net(*brain.getNeuralNetwork());
+        const int outputSize = net.outputSize();
+
+        std::string report = fmt::format("vecenv bench: episodes = {}, board = {}x{}\n", gameNum, row, col);
+        int mismatch = 0;
+
+        // the batched forward pass against NeuralNetwork::feedForward on real inputs
+        {
+            sim::VecEnv env(256, row, col, settings->wanderThreshold, 1);
+            std::vector<double> inputs(env.size() * sim::VecEnv::c_inputSize);
+            std::vector<double> outputs(env.size() * outputSize);
+            std::vector<int8_t> directions(env.size());
+            int outputMismatch = 0;
+
+            for (int s = 0; s < 20; s++) {
+                env.buildInputs(inputs.data());
+                net.forward(inputs.data(), env.size(), outputs.data());
+
+                for (int i = 0; i < env.size(); i++) {
+                    std::vector<double> input(inputs.begin() + i * sim::VecEnv::c_inputSize, inputs.begin() + (i + 1) * sim::VecEnv::c_inputSize);
+                    brain.getNeuralNetwork()->setInput(input);
+                    brain.getNeuralNetwork()->feedForward();
+                    auto expected = brain.getNeuralNetwork()->activatedValVectorOfLayerAt(brain.getNeuralNetwork()->getTopology().size() - 1);
+                    if (!std::equal(expected->begin(), expected->end(), outputs.begin() + i * outputSize)) {
+                        outputMismatch++;
+                    }
+                    directions[i] = SnakeBrain::directionOf(&outputs[i * outputSize], outputSize).rawValue();
+                }
+                env.step(directions.data());
+            }
+
+            report += fmt::format("  batch forward: samples = {}, mismatches = {}\n", 20 * env.size(), outputMismatch);
+            mismatch += outputMismatch;
+        }
+
+        for (int lanes : {16, 64, 256}) {
+            sim::VecEnv env(lanes, row, col, settings->wanderThreshold, 1);
+            std::vector<double> inputs(lanes * sim::VecEnv::c_inputSize);
+            std::vector<double> outputs(lanes * outputSize);
+            std::vector<int8_t> directions(lanes);
+            std::vector<sim::EpisodeResult> episodes;
+            long long steps = 0;
+
+            // every game observed, thought about in one batch, moved in one step
+            auto start = Clock::now();
+            while (int(episodes.size()) < gameNum) {
+                env.buildInputs(inputs.data());
+                net.forward(inputs.data(), lanes, outputs.data());
+                for (int i = 0; i < lanes; i++) {
+                    directions[i] = SnakeBrain::directionOf(&outputs[i * outputSize], outputSize).rawValue();
+                }
+
+                env.step(directions.data());
+                steps += lanes;
+
+                for (int i = 0; i < lanes; i++) {
+                    if (env.done()[i]) {
+                        episodes.push_back(env.episode(i));
+                    }
+                }
+            }
+            const double envMs = elapsedMs(start);
+
+            // the same episodes one at a time through playGame and SnakeBrain::think
+            sim::HeadlessGame game(row, col, settings->wanderThreshold);
+            long long gameSteps = 0;
+            int episodeMismatch = 0;
+            start = Clock::now();
+            for (const auto &e : episodes) {
+                game.reset(e.seed);
+                sim::playGame(game, brain, 0);
+
+                const sim::GameState &s = game.state();
+                gameSteps += s.totalSteps;
+                if (s.score != e.score || s.totalSteps != e.totalSteps || s.eatSteps != e.eatSteps || s.last != e.end) {
+                    episodeMismatch++;
+                }
+            }
+            const double gameMs = elapsedMs(start);
+
+            // the vector env also counts the moves of the games still running at the end
+            report += fmt::format("  lanes = {:3}: episodes = {}, mismatches = {}\n", lanes, episodes.size(), episodeMismatch);
+            report += fmt::format("    playGame + think    : {}\n", rate(gameSteps, gameMs));
+            report += fmt::format("    VecEnv + BatchNetwork: {} ({:.1f}x)\n", rate(steps, envMs),
+                                  envMs > 0 && gameMs > 0 ? (steps / envMs) / (gameSteps / gameMs) : 0.0);
+            mismatch += episodeMismatch;
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
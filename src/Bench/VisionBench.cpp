@@ -0,0 +1,94 @@
+#include "Bench/Bench.h"
+
+#include "Bench/ChasePolicy.h"
+#include "Simulation/HeadlessGame.h"
+#include <chrono>
+#include <fmt/core.h>
+#include <glog/logging.h>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+    // plays the bench games, calling vision(game, buffer) before every move
+    template <typename Vision>
+    long long playAll(sim::HeadlessGame &game, int gameNum, Vision &&vision) {
+        long long steps = 0;
+        for (int g = 0; g < gameNum; g++) {
+            std::minstd_rand rng(g + 1);
+            game.reset(g + 1);
+            while (game.isAlive()) {
+                vision(game);
+                game.setDirection(bench::chase(game, rng));
+                game.step();
+                steps++;
+            }
+        }
+        return steps;
+    }
+
+} // namespace
+
+namespace bench {
+
+    int vision() {
+        const int gameNum = std::max(1, FLAGS_bench_games);
+        int mismatch = 0;
+        std::string report = fmt::format("vision bench: games = {} per board\n", gameNum);
+
+        using Builder = void (sim::HeadlessGame::*)(double *) const;
+        const std::vector<std::pair<std::string, Builder>> builders{
+            {"walk", &sim::HeadlessGame::buildVisionByWalk},
+            {"bitboard", &sim::HeadlessGame::buildVision},
+        };
+
+        for (int n : {10, 16, 20, 32}) {
+            sim::HeadlessGame game(n, n, n * n - 1);
+            double reference[sim::HeadlessGame::c_visionSize];
+            double vision[sim::HeadlessGame::c_visionSize];
+
+            // every builder against the walk at every step
+            int boardMismatch = 0;
+            long long steps = playAll(game, gameNum, [&](const sim::HeadlessGame &g) {
+                g.buildVisionByWalk(reference);
+                for (const auto &b : builders) {
+                    (g.*b.second)(vision);
+                    if (!std::equal(reference, reference + sim::HeadlessGame::c_visionSize, vision)) {
+                        boardMismatch++;
+                    }
+                }
+            });
+
+            // the games alone, then with each vision, the difference is the vision cost
+            double checksum = 0;
+            auto start = Clock::now();
+            playAll(game, gameNum, [](const sim::HeadlessGame &) {});
+            std::chrono::duration<double, std::milli> baseMs = Clock::now() - start;
+
+            std::string timings;
+            double walkMs = 0;
+            for (const auto &b : builders) {
+                start = Clock::now();
+                playAll(game, gameNum, [&](const sim::HeadlessGame &g) {
+                    (g.*b.second)(vision);
+                    checksum += vision[0];
+                });
+                double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() - baseMs.count();
+                walkMs = walkMs > 0 ? walkMs : ms;
+                timings += fmt::format(", {} = {:.3f} ms ({:.1f}x)", b.first, ms, ms > 0 ? walkMs / ms : 0.0);
+            }
+
+            report += fmt::format("  {:2}x{:<2}: steps = {:9}, mismatches = {}{}, checksum = {:.3g}\n",
+                                  n, n, steps, boardMismatch, timings, checksum);
+            mismatch += boardMismatch;
+        }
+
+        fmt::print("{}", report);
+        LOG(INFO) << report;
+
+        return mismatch == 0 ? 0 : 1;
+    }
+
+} // namespace bench
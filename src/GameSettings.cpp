@@ -0,0 +1,27 @@
+#include "GameSettings.h"
+
+#include "AppConfig.h"
+#include <algorithm>
+
+std::shared_ptr<const GameSettings> GameSettings::capture() {
+    auto settings = std::make_shared<GameSettings>();
+
+    settings->runMode = AppConfig::RunMode();
+    settings->playManually = AppConfig::PlayManually();
+
+    settings->row = AppConfig::PlayboardRowNum();
+    settings->col = AppConfig::PlayboardColNum();
+    settings->size = AppConfig::PlayboardSize();
+
+    const int initSnakeLen = 1;
+    const int strictThreshold = settings->size - initSnakeLen;
+    settings->wanderThreshold = AppConfig::StrictWander() ? strictThreshold : std::max(AppConfig::WanderThreshold(), strictThreshold);
+
+    settings->initInterval = AppConfig::InitInterval();
+    settings->minInterval = AppConfig::MinInterval();
+    settings->intervalStep = AppConfig::IntervalStep();
+
+    settings->topology = AppConfig::TrainingTopology();
+
+    return settings;
+}
@@ -48,28 +48,28 @@ InfoboardModel::~InfoboardModel() {
 void InfoboardModel::update() {
 }
 
-void InfoboardModel::field_changed(SnakeModel &source, const std::string &field_name) {
-    if (field_name == "score") {
+void InfoboardModel::field_changed(SnakeModel &source, SnakeEvent::Type event) {
+    if (event == SnakeEvent::score) {
 
         std::string newScoreStr = fmt::format("Score: {}", source.getScore());
         setScoreStr(newScoreStr);
 
-    } else if (field_name == "refreshTime") {
+    } else if (event == SnakeEvent::refreshTime) {
 
         std::string newRefreshTimeStr = fmt::format("MoveInterval: {} ms", source.getMoveInterval());
         setRefreshTimeStr(newRefreshTimeStr);
 
-    } else if (field_name == "direction") {
+    } else if (event == SnakeEvent::direction) {
 
         std::string newDirectionStr = fmt::format("Direction: {}", source.getCurrentDirection().toString());
         setDirectionStr(newDirectionStr);
 
-    } else if (field_name == "stepCount") {
+    } else if (event == SnakeEvent::stepCount) {
 
         std::string newStepCountStr = fmt::format("StepCount: {}", source.getTotalStepCount());
         setStepCountStr(newStepCountStr);
 
-    } else if (field_name == "nextDirection") {
+    } else if (event == SnakeEvent::nextDirection) {
 
         if (AppConfig::RunMode().isAIMode()) {
             json description = source.getBrain()->getNeuralNetwork()->getDescription();
@@ -86,18 +86,18 @@ void InfoboardModel::field_changed(SnakeModel &source, const std::string &field_
             m_downStr = fmt::format("Down = {}", vec->at(2));
             m_leftStr = fmt::format("Left = {}", vec->at(3));
         }
-        this->notify(*this, "nextDirectionStr");
+        this->notify(*this, InfoboardEvent::nextDirectionStr);
 
-    } else if (field_name == "state") {
+    } else if (event == SnakeEvent::state) {
         setInfoStr(source.getStateInfo());
-        this->notify(*this, "infoStr");
+        this->notify(*this, InfoboardEvent::infoStr);
     } else {
         // not interest in these events
     }
 }
 
-void InfoboardModel::field_changed(SnakeApp &source, const std::string &field_name) {
-    if (field_name == "state") {
+void InfoboardModel::field_changed(SnakeApp &source, AppEvent::Type event) {
+    if (event == AppEvent::state) {
         std::string newGameStateStr = fmt::format("Game State: {}", source.getState().description());
         setGameStateStr(newGameStateStr);
 
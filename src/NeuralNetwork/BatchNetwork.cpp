@@ -0,0 +1,77 @@
+#include "NeuralNetwork/BatchNetwork.h"
+
+#include <algorithm>
+
+#include "NeuralNetwork/NeuralNetwork.h"
+
+BatchNetwork::BatchNetwork(NeuralNetwork &nn) {
+    const std::vector<int> &topology = nn.getTopology();
+
+    m_inputSize = topology.front();
+    m_outputSize = topology.back();
+    m_bias = nn.getBias();
+
+    for (size_t i = 0; i + 1 < topology.size(); i++) {
+        LayerWeights layer;
+        layer.in = topology[i];
+        layer.out = topology[i + 1];
+        layer.type = nn.layerActivateTypeAt(i + 1);
+        layer.activate = NN::Activation::ActivateMap.at(layer.type);
+
+        auto weight = nn.weightMatrixAt(i);
+        layer.weights.resize(layer.in * layer.out);
+        for (int k = 0; k < layer.in; k++) {
+            for (int j = 0; j < layer.out; j++) {
+                layer.weights[k * layer.out + j] = weight->getValue(k, j);
+            }
+        }
+
+        m_layers.push_back(std::move(layer));
+    }
+}
+
+void BatchNetwork::forward(const double *input, int batch, double *output) {
+    m_values.resize(m_inputSize * batch);
+    for (int b = 0; b < batch; b++) {
+        for (int k = 0; k < m_inputSize; k++) {
+            m_values[k * batch + b] = input[b * m_inputSize + k];
+        }
+    }
+
+    for (const auto &layer : m_layers) {
+        m_next.assign(layer.out * batch, 0.0);
+
+        for (int j = 0; j < layer.out; j++) {
+            double *sum = &m_next[j * batch];
+            for (int k = 0; k < layer.in; k++) {
+                const double w = layer.weights[k * layer.out + j];
+                const double *a = &m_values[k * batch];
+                for (int b = 0; b < batch; b++) {
+                    sum[b] += a[b] * w;
+                }
+            }
+        }
+
+        // Neuron::setVal, relu inline as it is on every hidden layer
+        for (auto &v : m_next) {
+            v += m_bias;
+        }
+        if (layer.type == NN::ActivationType::relu) {
+            for (auto &v : m_next) {
+                v = std::max(0.0, v);
+            }
+        } else if (layer.activate) {
+            for (auto &v : m_next) {
+                v = layer.activate(v);
+            }
+        }
+
+        std::swap(m_values, m_next);
+    }
+
+    for (int b = 0; b < batch; b++) {
+        for (int j = 0; j < m_outputSize; j++) {
+            output[b * m_outputSize + j] = m_values[j * batch + b];
+        }
+    }
+}
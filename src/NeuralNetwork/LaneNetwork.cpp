@@ -0,0 +1,111 @@
+#include "NeuralNetwork/LaneNetwork.h"
+
+#include <algorithm>
+
+#include "NeuralNetwork/NeuralNetwork.h"
+
+LaneNetwork::LaneNetwork(const std::vector<int> &topology, int laneNum) {
+    m_topology = topology;
+    m_laneNum = laneNum;
+    m_bias = 1.0;
+
+    for (size_t i = 0; i + 1 < topology.size(); i++) {
+        LayerWeights layer;
+        layer.in = topology[i];
+        layer.out = topology[i + 1];
+        layer.weights.assign(layer.in * layer.out * laneNum, 0.0);
+        layer.type = NN::ActivationType::none;
+        layer.activate = nullptr;
+
+        m_layers.push_back(std::move(layer));
+    }
+
+    // sized for the widest layer, forward does not allocate
+    const int widest = *std::max_element(topology.begin(), topology.end());
+    m_values.reserve(widest * laneNum);
+    m_next.reserve(widest * laneNum);
+}
+
+void LaneNetwork::setActivations(NeuralNetwork &nn) {
+    m_bias = nn.getBias();
+
+    for (size_t i = 0; i < m_layers.size(); i++) {
+        LayerWeights &layer = m_layers[i];
+        layer.type = nn.layerActivateTypeAt(i + 1);
+        layer.activate = NN::Activation::ActivateMap.at(layer.type);
+    }
+}
+
+void LaneNetwork::setLane(int lane, const double *genome) {
+    for (auto &layer : m_layers) {
+        for (int k = 0; k < layer.in; k++) {
+            for (int j = 0; j < layer.out; j++) {
+                layer.weights[(k * layer.out + j) * m_laneNum + lane] = *genome++;
+            }
+        }
+    }
+}
+
+void LaneNetwork::setLane(int lane, NeuralNetwork &nn) {
+    setActivations(nn);
+
+    for (size_t i = 0; i < m_layers.size(); i++) {
+        LayerWeights &layer = m_layers[i];
+
+        auto weight = nn.weightMatrixAt(i);
+        for (int k = 0; k < layer.in; k++) {
+            for (int j = 0; j < layer.out; j++) {
+                layer.weights[(k * layer.out + j) * m_laneNum + lane] = weight->getValue(k, j);
+            }
+        }
+    }
+}
+
+void LaneNetwork::forward(const double *input, double *output) {
+    const int inputSize = m_topology.front();
+    const int outputSize = m_topology.back();
+
+    m_values.resize(inputSize * m_laneNum);
+    for (int l = 0; l < m_laneNum; l++) {
+        for (int k = 0; k < inputSize; k++) {
+            m_values[k * m_laneNum + l] = input[l * inputSize + k];
+        }
+    }
+
+    for (const auto &layer : m_layers) {
+        m_next.assign(layer.out * m_laneNum, 0.0);
+
+        for (int j = 0; j < layer.out; j++) {
+            double *sum = &m_next[j * m_laneNum];
+            for (int k = 0; k < layer.in; k++) {
+                const double *w = &layer.weights[(k * layer.out + j) * m_laneNum];
+                const double *a = &m_values[k * m_laneNum];
+                for (int l = 0; l < m_laneNum; l++) {
+                    sum[l] += a[l] * w[l];
+                }
+            }
+        }
+
+        // Neuron::setVal, relu inline as it is on every hidden layer
+        for (auto &v : m_next) {
+            v += m_bias;
+        }
+        if (layer.type == NN::ActivationType::relu) {
+            for (auto &v : m_next) {
+                v = std::max(0.0, v);
+            }
+        } else if (layer.activate) {
+            for (auto &v : m_next) {
+                v = layer.activate(v);
+            }
+        }
+
+        std::swap(m_values, m_next);
+    }
+
+    for (int l = 0; l < m_laneNum; l++) {
+        for (int j = 0; j < outputSize; j++) {
+            output[l * outputSize + j] = m_values[j * m_laneNum + l];
+        }
+    }
+}
@@ -1,5 +1,6 @@
 #include "NeuralNetwork/Layer.h"
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 
@@ -31,6 +32,26 @@ void Layer::setValAt(int index, double val) {
 
 double Layer::getValAt(int index) { return this->m_neurons[index]->getVal(); }
 
+void Layer::getVals(double *vals, bool activated) {
+    for (int i = 0; i < this->m_size; i++) {
+        vals[i] = activated ? this->m_neurons[i]->getActivatedVal() : this->m_neurons[i]->getVal();
+    }
+}
+
+void Layer::setVals(const double *vals) {
+    // relu inline as it is on every hidden layer, the others through m_activate
+    if (this->m_activateType == NN::ActivationType::relu) {
+        for (int i = 0; i < this->m_size; i++) {
+            this->m_neurons[i]->setActivated(vals[i], std::max(0.0, vals[i]));
+        }
+        return;
+    }
+
+    for (int i = 0; i < this->m_size; i++) {
+        this->m_neurons[i]->setVal(vals[i], this->m_activate, nullptr);
+    }
+}
+
 void Layer::setActivateType(NN::ActivationType type) {
     this->m_activateType = type;
     this->m_activate = NN::Activation::ActivateMap[type];
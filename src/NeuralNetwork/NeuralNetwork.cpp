@@ -1,5 +1,6 @@
 #include "NeuralNetwork/NeuralNetwork.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <nlohmann/json.hpp>
@@ -59,6 +60,11 @@ void NeuralNetwork::initLayers() {
     for (int i = 0; i < m_topologySize; i++) {
         this->m_layers.push_back(std::make_shared<Layer>(m_topology[i]));
     }
+
+    // sized for the widest layer, feedForward does not allocate
+    const int widest = *std::max_element(m_topology.begin(), m_topology.end());
+    m_in.assign(widest, 0.0);
+    m_sum.assign(widest, 0.0);
 }
 void NeuralNetwork::initWeightMatrices(bool initWithRandom) {
     m_weightMatrices.clear();
@@ -75,35 +81,47 @@ void NeuralNetwork::setWeightMatricesWithRandomValue() {
 
 void NeuralNetwork::feedForward() {
 
+    // the sums of MatrixMath::multiply on the 1 x n neuron row, each in the same
+    // order, k outer so the weights are read a row at a time. the neurons are
+    // read and written once per layer, not once per weight
     for (int i = 0; i < (this->m_topologySize - 1); i++) {
 
-        std::shared_ptr<Matrix> a = nullptr; // Matrix of neurons to the left
-        std::shared_ptr<Matrix> b = nullptr; // Matrix of weights to the right of layer
-        std::shared_ptr<Matrix> c = nullptr; // Matrix of neurons to the next layer
-
-        if (i == 0) {
-            a = this->valMatrixOfLayerAt(i);
-        } else {
-            a = this->activatedValMatrixOfLayerAt(i);
+        Layer &a = *this->m_layers[i];                               // neurons to the left
+        const auto &b = this->m_weightMatrices[i]->getValues();      // weights to the right of layer
+        const int in = this->m_topology[i];
+        const int out = this->m_topology[i + 1];
+
+        a.getVals(m_in.data(), i > 0);
+        std::fill(m_sum.begin(), m_sum.begin() + out, 0.0);
+        for (int k = 0; k < in; k++) {
+            const double v = m_in[k];
+            const double *w = b[k].data();
+            for (int j = 0; j < out; j++) {
+                m_sum[j] += v * w[j];
+            }
         }
 
-        b = this->weightMatrixAt(i);
-        c = std::make_shared<Matrix>(a->getRowNum(), b->getColNum(), false);
-
-        NN::MatrixMath::multiply(a, b, c);
-
-        for (int c_index = 0; c_index < c->getColNum(); c_index++) {
-
-            this->setNeuronValue(i + 1, c_index, c->getValue(0, c_index) + this->m_bias);
+        for (int j = 0; j < out; j++) {
+            m_sum[j] += this->m_bias;
         }
+        this->m_layers[i + 1]->setVals(m_sum.data());
     }
 }
 
 void NeuralNetwork::setInput(const std::vector<double> &input) {
-    this->m_input = input;
+    setInput(input.data(), input.size());
+}
+
+void NeuralNetwork::setInput(const double *input, int size) {
+    for (int i = 0; i < size; i++) {
+        this->m_layers.at(0)->setValAt(i, input[i]);
+    }
+}
 
-    for (size_t i = 0; i < input.size(); i++) {
-        this->m_layers.at(0)->setValAt(i, input.at(i));
+void NeuralNetwork::activatedValuesOfLayerAt(int index, double *values) {
+    Layer &layer = *this->m_layers.at(index);
+    for (int i = 0; i < this->m_topology.at(index); i++) {
+        values[i] = layer.getActivatedValAt(i);
     }
 }
 
@@ -4,26 +4,15 @@
 
 #include <string>
 
-#include "AppConfig.h"
 #include "EntityManager.h"
 #include "SnakeApp.h"
 #include "SnakeModel.h"
 
 using namespace std;
 
-PlayboardModel::PlayboardModel() {
-    m_row = 10;
-    m_col = 10;
-
-    m_applePosition.row = -1;
-    m_applePosition.col = -1;
-
-    PlayboardModel(m_row, m_col);
-}
-
-PlayboardModel::PlayboardModel(int row, int col) {
-    m_row = row;
-    m_col = col;
+PlayboardModel::PlayboardModel(std::shared_ptr<const GameSettings> settings) : m_settings(std::move(settings)) {
+    m_row = m_settings->row;
+    m_col = m_settings->col;
 
     m_applePosition.row = -1;
     m_applePosition.col = -1;
@@ -33,6 +22,7 @@ PlayboardModel::PlayboardModel(int row, int col) {
         m_board[i] = new char[m_col];
         memset(m_board[i], DEFAULT_EMPTY, m_col);
     }
+    m_freeCells = sim::FreeCellSet(m_row * m_col);
 }
 
 PlayboardModel::~PlayboardModel() {
@@ -51,6 +41,7 @@ void PlayboardModel::reset() {
     for (auto i = 0; i < m_row; i++) {
         memset(m_board[i], DEFAULT_EMPTY, m_col);
     }
+    m_freeCells.fill();
 
     m_applePosition.row = -1;
     m_applePosition.col = -1;
@@ -66,7 +57,7 @@ void PlayboardModel::eraseApple() {
     m_applePosition.row = -1;
     m_applePosition.col = -1;
 
-    this->notify(*this, "eraseApple");
+    this->notify(*this, PlayboardEvent::eraseApple);
 }
 
 void PlayboardModel::placeApple() {
@@ -78,12 +69,12 @@ void PlayboardModel::placeApple() {
 
     this->addBlock(AppleBlock(m_applePosition));
 
-    this->notify(*this, "placeApple");
+    this->notify(*this, PlayboardEvent::placeApple);
 }
 
-void PlayboardModel::field_changed(SnakeModel &source, const string &field_name) {
+void PlayboardModel::field_changed(SnakeModel &source, SnakeEvent::Type event) {
 
-    if (field_name == "move") {
+    if (event == SnakeEvent::move) {
 
         bool isInBound = isWithinBound(source.getNextHeadPostion());
 
@@ -98,7 +89,7 @@ void PlayboardModel::field_changed(SnakeModel &source, const string &field_name)
         } else if (this->isEmpty(source.getNextHeadPostion().row, source.getNextHeadPostion().col)) {
             source.forward();
         } else if (this->isSnake(source.getNextHeadPostion().row, source.getNextHeadPostion().col)) {
-            if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+            if (!m_settings->runMode.isTrainMode()) {
                 LOG(INFO) << "Snake bite itself.";
             }
             source.setStateInfo("Snake bite itself.");
@@ -107,15 +98,15 @@ void PlayboardModel::field_changed(SnakeModel &source, const string &field_name)
             source.setState(SnakeState::die);
         }
 
-    } else if (field_name == "addHeadBlock") {
+    } else if (event == SnakeEvent::addHeadBlock) {
 
         this->addBlock(SnakeBlock(source.getNextHeadPostion()));
 
-    } else if (field_name == "removeTailBlock") {
+    } else if (event == SnakeEvent::removeTailBlock) {
 
         this->addBlock(EmptyBlock(source.removedTailPosition()));
 
-    } else if (field_name == "eat") {
+    } else if (event == SnakeEvent::eat) {
 
         eraseApple();
         placeApple();
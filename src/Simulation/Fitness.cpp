@@ -0,0 +1,88 @@
+#include "Simulation/Fitness.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fmt/core.h>
+#include <limits>
+
+namespace sim {
+
+    long double fitness(int score, int totalSteps) {
+
+        long double d = 100000.0;
+        long double rewardScoreAndExplore = score + 0.5 + (0.5 * (totalSteps - (totalSteps / (score + 1.0))) / (totalSteps + (totalSteps / (score + 1.0))));
+        long double rank = 0;
+
+#if 1
+        // reward lessAvgStep make the snake less wander, just go strait for apple as much as possible.
+        // these paramters is tuned for 10x10 playboard
+        // need adjust if training snake in other size,
+        double exponentStart = 1.9;
+        double delta = score / 10 * 0.03;
+        double exponent = exponentStart - delta;
+        long double rewardLessAvgStep = (1.0 / (totalSteps / (score + 1.0))) * pow(rewardScoreAndExplore + 0.5, exponent);
+        rank = rewardScoreAndExplore + rewardLessAvgStep;
+#else
+        // simple and fast
+        // but the totalsteps will be large.
+        rank = rewardScoreAndExplore;
+#endif
+        rank *= d;
+
+        long double max = std::numeric_limits<long double>::max();
+        if (rank > max) {
+            fmt::print("m_rank is big than max {}\n", max);
+            rank = max;
+        }
+
+        return rank;
+    }
+
+    FitnessAggregate fitnessAggregateOf(const std::string &name) {
+        if (name == "min") {
+            return FitnessAggregate::min;
+        }
+        if (name == "quantile") {
+            return FitnessAggregate::quantile;
+        }
+        return FitnessAggregate::mean;
+    }
+
+    const char *nameOf(FitnessAggregate aggregate) {
+        switch (aggregate) {
+        case FitnessAggregate::min:
+            return "min";
+        case FitnessAggregate::quantile:
+            return "quantile";
+        default:
+            return "mean";
+        }
+    }
+
+    long double aggregateFitness(long double *values, int n, FitnessAggregate aggregate, double quantile) {
+        if (n <= 0) {
+            return 0;
+        }
+
+        switch (aggregate) {
+        case FitnessAggregate::min:
+            return *std::min_element(values, values + n);
+
+        case FitnessAggregate::quantile: {
+            // nearest rank, no interpolation between two games
+            int k = std::clamp(int(std::floor(std::clamp(quantile, 0.0, 1.0) * (n - 1) + 0.5)), 0, n - 1);
+            std::nth_element(values, values + k, values + n);
+            return values[k];
+        }
+
+        default: {
+            long double sum = 0;
+            for (int i = 0; i < n; i++) {
+                sum += values[i];
+            }
+            return sum / n;
+        }
+        }
+    }
+
+} // namespace sim
@@ -0,0 +1,329 @@
+#include "Simulation/HeadlessGame.h"
+
+#include "SnakeBrain.h"
+#include "Simulation/Moves.h"
+#include "Simulation/Vision.h"
+#include "SnakeDirection.h"
+#include <algorithm>
+#include <glog/logging.h>
+
+namespace sim {
+
+    template <typename Dims>
+    BasicHeadlessGame<Dims>::BasicHeadlessGame(Dims dims, int wanderThreshold)
+        : m_dims(dims),
+          m_wanderThreshold(wanderThreshold),
+          m_state(),
+          m_cells(),
+          m_body(),
+          m_bodyHead(0),
+          m_expiryBody(false),
+          m_expiryBodyNext(false),
+          m_expiry(),
+          m_freeCells(dims.size()),
+          m_rays(&RayTable::get(dims.row(), dims.col())),
+          m_bodyPlane(dims.size()),
+          m_tiled(std::max(dims.row(), dims.col()) > c_tiledBoardSize),
+          m_bodyTiles() {
+
+        const int row = dims.row();
+        const int lineNum = std::max(row, dims.col()) + 1;
+
+        resizeArray(m_cells, dims.size());
+        resizeArray(m_body, dims.size());
+        std::fill(m_cells.begin(), m_cells.end(), Cell::empty);
+        std::fill(m_body.begin(), m_body.end(), 0);
+
+        resizeArray(m_wallValue, lineNum);
+        resizeArray(m_bodyValue, lineNum);
+        resizeArray(m_foodValue, lineNum);
+        for (int distance = -1; distance < lineNum - 1; distance++) {
+            m_wallValue[distance + 1] = sim::wallValue(std::max(distance, 0), row);
+            m_bodyValue[distance + 1] = sim::bodyValue(distance, row);
+            m_foodValue[distance + 1] = sim::foodValue(distance, row);
+        }
+
+        if (m_tiled) {
+            m_bodyTiles.emplace(dims.row(), dims.col());
+        }
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::setLoopDetection(bool on) {
+        if (on != m_loops.isEnabled()) {
+            m_loops = on ? LoopDetector(m_wanderThreshold + 1) : LoopDetector();
+        }
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::setTiledOccupancy(bool on) {
+        if (on && !m_tiled) {
+            // the tiles were not kept, the body of the game so far
+            if (!m_bodyTiles) {
+                m_bodyTiles.emplace(m_dims.row(), m_dims.col());
+            }
+            m_bodyTiles->clear();
+            for (int cell = 0; cell < m_dims.size(); cell++) {
+                if (m_cells[cell] == Cell::snake) {
+                    m_bodyTiles->set(cell / m_dims.col(), cell % m_dims.col());
+                }
+            }
+        }
+        m_tiled = on;
+    }
+
+    template <typename Dims>
+    int BasicHeadlessGame<Dims>::randomNumber(int low, int high) {
+        // the exact distribution utility::random::generateRandomNumber uses
+        std::uniform_int_distribution<std::minstd_rand::result_type> dist(low, high);
+        return dist(m_rng);
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::reset(unsigned int seed) {
+        m_rng.seed(seed);
+
+        std::fill(m_cells.begin(), m_cells.end(), Cell::empty);
+        m_freeCells.fill();
+        m_bodyPlane.clear();
+        if (m_tiled) {
+            m_bodyTiles->clear();
+        }
+        m_state = GameState{};
+        m_state.apple = -1;
+        m_bodyHead = 0;
+        m_expiryBody = m_expiryBodyNext;
+        if (m_expiryBody) {
+            if (m_expiry.cellNum() == 0) {
+                m_expiry = ExpiryGrid(m_dims.row(), m_dims.col());
+            }
+            m_expiry.clear();
+        }
+
+        int d = 0;
+        while (d = randomNumber(-2, 2), d == 0)
+            ;
+
+        int offset = int(m_dims.row() * 0.3); /* make the snake not closer to the bound */
+        int row = randomNumber(offset, m_dims.row() - offset);
+        int col = randomNumber(offset, m_dims.col() - offset);
+
+        m_state.direction = int8_t(d);
+        m_state.alive = true;
+        m_state.last = StepResult::moved;
+        addHead(row, col);
+        m_loops.start(row * m_dims.col() + col);
+
+        placeApple();
+    }
+
+    template <typename Dims>
+    StepResult BasicHeadlessGame<Dims>::step() {
+        if (!m_state.alive) {
+            return m_state.last;
+        }
+
+        const Delta &delta = c_moveDelta[m_state.direction + 2];
+        const int row = m_state.headRow + delta.row;
+        const int col = m_state.headCol + delta.col;
+
+        if (unsigned(row) >= unsigned(m_dims.row()) || unsigned(col) >= unsigned(m_dims.col())) {
+            die(StepResult::hitWall);
+            return m_state.last;
+        }
+
+        switch (m_cells[row * m_dims.col() + col]) {
+        case Cell::apple:
+            m_state.apple = -1;
+            m_state.score++;
+            m_state.totalSteps++;
+            m_state.eatSteps = m_state.totalSteps;
+            addHead(row, col);
+            m_loops.grow(row * m_dims.col() + col);
+
+            if (m_state.score == m_dims.size() - 1) {
+                // perfect snake, R.I.P
+                die(StepResult::perfect);
+                return m_state.last;
+            }
+
+            m_state.last = StepResult::ate;
+            placeApple();
+            break;
+
+        case Cell::empty: {
+            int freed = removeTail();
+            addHead(row, col);
+            m_loops.shift(row * m_dims.col() + col, freed);
+            m_state.totalSteps++;
+            m_state.last = StepResult::moved;
+            break;
+        }
+
+        default:
+            die(StepResult::biteSelf);
+            return m_state.last;
+        }
+
+        if (m_state.totalSteps - m_state.eatSteps > m_wanderThreshold) {
+            die(StepResult::wandered);
+        } else if (m_loops.isEnabled() && m_loops.repeated(m_state.direction)) {
+            m_state.totalSteps = m_state.eatSteps + m_wanderThreshold + 1;
+            die(StepResult::looped);
+        }
+
+        return m_state.last;
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::buildVision(double *vision) const {
+        const int head = m_state.headRow * m_dims.col() + m_state.headCol;
+
+        int appleDistance = -1;
+        const int appleRay = m_state.apple >= 0 ? m_rays->rayTo(head, m_state.apple, appleDistance) : -1;
+
+        for (int ray = 0; ray < RayTable::c_rayNum; ray++) {
+            const int body = m_tiled ? m_bodyTiles->nearest(m_state.headRow, m_state.headCol, ray)
+                                     : m_rays->nearest(m_bodyPlane, head, ray);
+
+            *vision++ = m_wallValue[m_rays->wallDistance(head, ray) + 1];
+            *vision++ = m_bodyValue[body + 1];
+            *vision++ = m_foodValue[(ray == appleRay ? appleDistance : -1) + 1];
+        }
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::buildVisionByWalk(double *vision) const {
+        sim::walkVision(
+            m_state.headRow, m_state.headCol, m_dims.row(), m_dims.col(),
+            [this](int r, int c) { return m_cells[r * m_dims.col() + c] == Cell::snake; },
+            [this](int r, int c) { return m_cells[r * m_dims.col() + c] == Cell::apple; },
+            vision);
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::buildInput(double *input) const {
+        buildVision(input);
+        std::copy_n(c_directionVector[m_state.direction + 2], c_directionSize, input + c_visionSize);
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::addHead(int row, int col) {
+        const int cell = row * m_dims.col() + col;
+
+        if (m_expiryBody) {
+            m_expiry.grow(cell);
+        } else {
+            m_bodyHead = (m_bodyHead == 0 ? m_dims.size() : m_bodyHead) - 1;
+            m_body[m_bodyHead] = cell;
+        }
+        m_state.length++;
+
+        m_cells[cell] = Cell::snake;
+        m_freeCells.erase(cell);
+        m_bodyPlane.set(cell);
+        if (m_tiled) {
+            m_bodyTiles->set(row, col);
+        }
+        m_state.headRow = row;
+        m_state.headCol = col;
+    }
+
+    template <typename Dims>
+    int BasicHeadlessGame<Dims>::removeTail() {
+        int cell;
+        if (m_expiryBody) {
+            cell = m_expiry.popTail();
+        } else {
+            int tail = m_bodyHead + m_state.length - 1;
+            if (tail >= m_dims.size()) {
+                tail -= m_dims.size();
+            }
+            cell = m_body[tail];
+        }
+
+        m_cells[cell] = Cell::empty;
+        m_freeCells.insert(cell);
+        m_bodyPlane.reset(cell);
+        if (m_tiled) {
+            m_bodyTiles->reset(cell / m_dims.col(), cell % m_dims.col());
+        }
+        m_state.length--;
+
+        return cell;
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::placeApple() {
+        // PlayboardModel::getRandomEmptyPosition
+        m_state.apple = m_freeCells.at(randomNumber(0, m_freeCells.size() - 1));
+        m_cells[m_state.apple] = Cell::apple;
+        m_freeCells.erase(m_state.apple);
+    }
+
+    template <typename Dims>
+    void BasicHeadlessGame<Dims>::die(StepResult reason) {
+        m_state.alive = false;
+        m_state.last = reason;
+    }
+
+    template class BasicHeadlessGame<FixedDims<10, 10>>;
+    template class BasicHeadlessGame<FixedDims<16, 16>>;
+    template class BasicHeadlessGame<FixedDims<20, 20>>;
+    template class BasicHeadlessGame<FixedDims<32, 32>>;
+    template class BasicHeadlessGame<DynamicDims>;
+
+    namespace {
+
+        GameVariant makeGame(int row, int col, int wanderThreshold, bool allowFixed) {
+            if (allowFixed && row == col) {
+                switch (row) {
+                case 10:
+                    return BasicHeadlessGame<FixedDims<10, 10>>(FixedDims<10, 10>(), wanderThreshold);
+                case 16:
+                    return Boxed(BasicHeadlessGame<FixedDims<16, 16>>(FixedDims<16, 16>(), wanderThreshold));
+                case 20:
+                    return Boxed(BasicHeadlessGame<FixedDims<20, 20>>(FixedDims<20, 20>(), wanderThreshold));
+                case 32:
+                    return Boxed(BasicHeadlessGame<FixedDims<32, 32>>(FixedDims<32, 32>(), wanderThreshold));
+                default:
+                    break;
+                }
+            }
+            return BasicHeadlessGame<DynamicDims>(DynamicDims(row, col), wanderThreshold);
+        }
+
+        template <typename Game>
+        bool playTyped(Game &game, SnakeBrain &brain, int maxSteps) {
+            double input[Game::c_inputSize];
+
+            for (int step = 0; game.isAlive() && (maxSteps <= 0 || step < maxSteps); step++) {
+                game.step();
+                if (!game.isAlive()) {
+                    break;
+                }
+
+                game.buildInput(input);
+                SnakeDirection next = brain.think(input, Game::c_inputSize);
+                if (next != SnakeDirection::invalid) {
+                    game.setDirection(next.rawValue());
+                } else {
+                    LOG(ERROR) << "Predict direction invalid, keep forward. currDirection = " << SnakeDirection(game.state().direction).toString();
+                }
+            }
+
+            return !game.isAlive();
+        }
+
+    } // namespace
+
+    HeadlessGame::HeadlessGame(int row, int col, int wanderThreshold, bool allowFixed)
+        : m_row(row),
+          m_col(col),
+          m_game(makeGame(row, col, wanderThreshold, allowFixed)) {}
+
+    bool playGame(HeadlessGame &game, SnakeBrain &brain, int maxSteps) {
+        return std::visit([&](auto &g) { return playTyped(unbox(g), brain, maxSteps); }, game.variant());
+    }
+
+} // namespace sim
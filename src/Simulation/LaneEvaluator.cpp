@@ -0,0 +1,79 @@
+#include "Simulation/LaneEvaluator.h"
+
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "SnakeBrain.h"
+#include <glog/logging.h>
+
+namespace sim {
+
+    LaneEvaluator::LaneEvaluator(int laneNum, int row, int col, int wanderThreshold, NeuralNetwork &prototype)
+        : m_env(laneNum, row, col, wanderThreshold, 1),
+          m_network(prototype.getTopology(), laneNum),
+          m_index(laneNum, -1),
+          m_inputs(laneNum * VecEnv::c_inputSize),
+          m_outputs(laneNum * prototype.getTopology().back()),
+          m_directions(laneNum, 0) {
+        m_env.setAutoReset(false);
+        m_network.setActivations(prototype);
+    }
+
+    void LaneEvaluator::startLane(int lane, const NextJob &next, const Finished &finished) {
+        Job job;
+        while (next(job)) {
+            m_network.setLane(lane, job.genome);
+            m_env.reset(lane, job.seed);
+            if (m_env.isAlive(lane)) {
+                m_index[lane] = job.index;
+                return;
+            }
+            finished(job.index, m_env.episode(lane));
+        }
+        m_index[lane] = -1;
+    }
+
+    long long LaneEvaluator::run(const NextJob &next, const Finished &finished) {
+        const int laneNum = m_env.size();
+        const int outputSize = m_network.outputSize();
+
+        int active = 0;
+        for (int lane = 0; lane < laneNum; lane++) {
+            startLane(lane, next, finished);
+            active += m_index[lane] >= 0;
+        }
+
+        long long steps = 0;
+        while (active > 0) {
+            // the idle lanes think too, their games are over and do not move
+            m_env.buildInputs(m_inputs.data());
+            m_network.forward(m_inputs.data(), m_outputs.data());
+
+            for (int lane = 0; lane < laneNum; lane++) {
+                if (m_index[lane] < 0) {
+                    m_directions[lane] = SnakeDirection::invalid;
+                    continue;
+                }
+
+                SnakeDirection direction = SnakeBrain::directionOf(&m_outputs[lane * outputSize], outputSize);
+                if (direction == SnakeDirection::invalid) {
+                    LOG(ERROR) << "Predict direction invalid, keep forward. lane = " << lane;
+                }
+                m_directions[lane] = direction.rawValue();
+            }
+
+            m_env.step(m_directions.data());
+            steps += active;
+
+            active = 0;
+            for (int lane = 0; lane < laneNum; lane++) {
+                if (m_index[lane] >= 0 && m_env.done()[lane]) {
+                    finished(m_index[lane], m_env.episode(lane));
+                    startLane(lane, next, finished);
+                }
+                active += m_index[lane] >= 0;
+            }
+        }
+
+        return steps;
+    }
+
+} // namespace sim
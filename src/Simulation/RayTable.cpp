@@ -0,0 +1,94 @@
+#include "Simulation/RayTable.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+    // column, anti diagonal (row + col), row, diagonal (row - col)
+    constexpr int c_rayAxis[sim::RayTable::c_rayNum] = {0, 1, 2, 3, 0, 1, 2, 3};
+
+} // namespace
+
+namespace sim {
+
+    const RayTable &RayTable::get(int row, int col) {
+        static std::mutex mutex;
+        static std::map<std::pair<int, int>, std::unique_ptr<RayTable>> tables;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto &table = tables[{row, col}];
+        if (!table) {
+            table = std::make_unique<RayTable>(row, col);
+        }
+        return *table;
+    }
+
+    RayTable::RayTable(int row, int col) {
+        const int cellNum = row * col;
+        const int diagonalNum = row + col - 1;
+        const int lineNum = col + diagonalNum + row + diagonalNum;
+
+        m_wordNum = (cellNum + 63) / 64;
+        for (int r = 0; r < c_rayNum; r++) {
+            m_stride[r] = c_visionRay[r][0] * col + c_visionRay[r][1];
+        }
+
+        auto lineOf = [=](int r, int c, int axis) {
+            switch (axis) {
+            case 0:
+                return c;
+            case 1:
+                return col + r + c;
+            case 2:
+                return col + diagonalNum + r;
+            default:
+                return col + diagonalNum + row + r - c + (col - 1);
+            }
+        };
+
+        m_lineWords.assign(lineNum * m_wordNum, 0);
+        m_rowOf.resize(cellNum);
+        m_colOf.resize(cellNum);
+        for (int r = 0; r < row; r++) {
+            for (int c = 0; c < col; c++) {
+                const int cell = r * col + c;
+                m_rowOf[cell] = r;
+                m_colOf[cell] = c;
+                for (int axis = 0; axis < 4; axis++) {
+                    m_lineWords[lineOf(r, c, axis) * m_wordNum + (cell >> 6)] |= uint64_t(1) << (cell & 63);
+                }
+            }
+        }
+
+        m_rays.resize(cellNum * c_rayNum);
+        for (int r = 0; r < row; r++) {
+            for (int c = 0; c < col; c++) {
+                const int cell = r * col + c;
+
+                for (int ray = 0; ray < c_rayNum; ray++) {
+                    const int dr = c_visionRay[ray][0];
+                    const int dc = c_visionRay[ray][1];
+                    Ray &info = m_rays[cell * c_rayNum + ray];
+
+                    int distance = 0, last = cell;
+                    for (int rr = r + dr, cc = c + dc; rr >= 0 && rr < row && cc >= 0 && cc < col; rr += dr, cc += dc) {
+                        distance++;
+                        last = rr * col + cc;
+                    }
+
+                    const int bit = cell & 63;
+                    const uint64_t clip = m_stride[ray] > 0 ? (bit == 63 ? 0 : ~uint64_t(0) << (bit + 1))
+                                                            : (uint64_t(1) << bit) - 1;
+
+                    info.line = lineOf(r, c, c_rayAxis[ray]) * m_wordNum;
+                    info.firstMask = m_lineWords[info.line + (cell >> 6)] & clip;
+                    info.lastWord = last >> 6;
+                    info.wallDistance = distance;
+                }
+            }
+        }
+    }
+
+} // namespace sim
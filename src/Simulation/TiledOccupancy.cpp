@@ -0,0 +1,80 @@
+#include "Simulation/TiledOccupancy.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+
+    using RayMasks = std::array<std::array<uint64_t, 64>, sim::c_visionRayNum>;
+
+    // the cells of a tile on ray r from cell i on, i included
+    constexpr RayMasks buildRayMasks() {
+        RayMasks masks{};
+        for (int ray = 0; ray < sim::c_visionRayNum; ray++) {
+            for (int i = 0; i < 64; i++) {
+                uint64_t mask = 0;
+                for (int r = i / 8, c = i % 8; r >= 0 && r < 8 && c >= 0 && c < 8;
+                     r += sim::c_visionRay[ray][0], c += sim::c_visionRay[ray][1]) {
+                    mask |= uint64_t(1) << (r * 8 + c);
+                }
+                masks[ray][i] = mask;
+            }
+        }
+        return masks;
+    }
+
+    constexpr RayMasks c_rayMasks = buildRayMasks();
+
+} // namespace
+
+namespace sim {
+
+    TiledOccupancy::TiledOccupancy(int row, int col)
+        : m_row(row),
+          m_col(col),
+          m_tileCols((col + 7) / 8),
+          m_summaryCols((col + 63) / 64),
+          m_tiles(((row + 7) / 8) * m_tileCols, 0),
+          m_summary(((row + 63) / 64) * m_summaryCols, 0) {}
+
+    TiledOccupancy::TiledOccupancy(const TiledOccupancy &) = default;
+    TiledOccupancy::TiledOccupancy(TiledOccupancy &&) noexcept = default;
+    TiledOccupancy &TiledOccupancy::operator=(const TiledOccupancy &) = default;
+    TiledOccupancy &TiledOccupancy::operator=(TiledOccupancy &&) noexcept = default;
+
+    void TiledOccupancy::clear() {
+        std::fill(m_tiles.begin(), m_tiles.end(), 0);
+        std::fill(m_summary.begin(), m_summary.end(), 0);
+    }
+
+    int TiledOccupancy::nearest(int row, int col, int ray) const {
+        const int dr = c_visionRay[ray][0];
+        const int dc = c_visionRay[ray][1];
+        const bool ascending = dr * 8 + dc > 0; /* the bit index grows along the ray */
+
+        int r = row + dr, c = col + dc, steps = 1;
+        while (unsigned(r) < unsigned(m_row) && unsigned(c) < unsigned(m_col)) {
+            int skip = 0;
+            const uint64_t summary = m_summary[summaryOf(r, c)];
+            if (summary == 0) {
+                skip = stepsToLeave(r, c, dr, dc, 64);
+            } else if (((summary >> summaryBitOf(r, c)) & 1) == 0) {
+                skip = stepsToLeave(r, c, dr, dc, 8);
+            } else {
+                const uint64_t m = m_tiles[tileOf(r, c)] & c_rayMasks[ray][bitOf(r, c)];
+                if (m != 0) {
+                    const int hit = ascending ? lowestBit(m) : highestBit(m);
+                    const int ahead = dr != 0 ? ((hit >> 3) - (r & 7)) * dr : ((hit & 7) - (c & 7)) * dc;
+                    return steps + ahead - 1;
+                }
+                skip = stepsToLeave(r, c, dr, dc, 8);
+            }
+
+            r += skip * dr;
+            c += skip * dc;
+            steps += skip;
+        }
+        return -1;
+    }
+
+} // namespace sim
@@ -0,0 +1,308 @@
+#include "Simulation/VecEnv.h"
+
+#include "Simulation/Bitboard.h"
+#include "Simulation/Moves.h"
+#include <algorithm>
+#include <limits>
+
+namespace sim {
+
+    VecEnv::VecEnv(int gameNum, int row, int col, int wanderThreshold, unsigned int seed)
+        : m_gameNum(gameNum),
+          m_row(row),
+          m_col(col),
+          m_size(row * col),
+          m_wordNum((row * col + 63) / 64),
+          m_wanderThreshold(wanderThreshold),
+          m_headRow(gameNum, 0),
+          m_headCol(gameNum, 0),
+          m_direction(gameNum, 0),
+          m_score(gameNum, 0),
+          m_totalSteps(gameNum, 0),
+          m_eatSteps(gameNum, 0),
+          m_length(gameNum, 0),
+          m_apple(gameNum, -1),
+          m_bodyHead(gameNum, 0),
+          m_freeNum(gameNum, 0),
+          m_alive(gameNum, 0),
+          m_last(gameNum, StepResult::moved),
+          m_seed(gameNum, 0),
+          m_rng(gameNum),
+          m_loops(gameNum),
+          m_cells(gameNum * m_size, Cell::empty),
+          m_body(gameNum * m_size, 0),
+          m_freeCells(gameNum * m_size, 0),
+          m_freeSlot(gameNum * m_size, 0),
+          m_planes(gameNum * m_wordNum, 0),
+          m_target(gameNum, -1),
+          m_reward(gameNum, 0),
+          m_done(gameNum, 0),
+          m_episode(gameNum, EpisodeResult{}),
+          m_autoReset(true),
+          m_seedRng(seed),
+          m_rays(&RayTable::get(row, col)) {
+
+        for (int distance = -1; distance < std::max(row, col); distance++) {
+            m_wallValue.push_back(sim::wallValue(std::max(distance, 0), row));
+            m_bodyValue.push_back(sim::bodyValue(distance, row));
+            m_foodValue.push_back(sim::foodValue(distance, row));
+        }
+
+        reset();
+    }
+
+    void VecEnv::setLoopDetection(bool on) {
+        for (auto &loops : m_loops) {
+            if (on != loops.isEnabled()) {
+                loops = on ? LoopDetector(m_wanderThreshold + 1) : LoopDetector();
+            }
+        }
+    }
+
+    int VecEnv::randomNumber(int game, int low, int high) {
+        // the exact distribution utility::random::generateRandomNumber uses
+        std::uniform_int_distribution<std::minstd_rand::result_type> dist(low, high);
+        return dist(m_rng[game]);
+    }
+
+    void VecEnv::reset() {
+        std::uniform_int_distribution<unsigned int> dist(1, std::numeric_limits<int>::max());
+        for (int i = 0; i < m_gameNum; i++) {
+            reset(i, dist(m_seedRng));
+        }
+    }
+
+    void VecEnv::reset(int game, unsigned int seed) {
+        // HeadlessGame::reset
+        m_seed[game] = seed;
+        m_rng[game].seed(seed);
+
+        const int base = game * m_size;
+        std::fill_n(m_cells.begin() + base, m_size, Cell::empty);
+        std::fill_n(m_planes.begin() + game * m_wordNum, m_wordNum, 0);
+        for (int cell = 0; cell < m_size; cell++) {
+            m_freeCells[base + cell] = cell;
+            m_freeSlot[base + cell] = cell;
+        }
+        m_freeNum[game] = m_size;
+
+        m_score[game] = 0;
+        m_totalSteps[game] = 0;
+        m_eatSteps[game] = 0;
+        m_length[game] = 0;
+        m_apple[game] = -1;
+        m_bodyHead[game] = 0;
+
+        int d = 0;
+        while (d = randomNumber(game, -2, 2), d == 0)
+            ;
+
+        int offset = int(m_row * 0.3); /* make the snake not closer to the bound */
+        int row = randomNumber(game, offset, m_row - offset);
+        int col = randomNumber(game, offset, m_col - offset);
+
+        m_direction[game] = int8_t(d);
+        m_alive[game] = 1;
+        m_last[game] = StepResult::moved;
+        addHead(game, row * m_col + col);
+        m_loops[game].start(row * m_col + col);
+
+        placeApple(game);
+
+        // the first move is made before the brain ever looks
+        const Delta &delta = c_moveDelta[d + 2];
+        row += delta.row;
+        col += delta.col;
+        move(game, unsigned(row) < unsigned(m_row) && unsigned(col) < unsigned(m_col) ? row * m_col + col : -1);
+        if (m_alive[game] && m_totalSteps[game] - m_eatSteps[game] > m_wanderThreshold) {
+            m_alive[game] = 0;
+            m_last[game] = StepResult::wandered;
+        } else if (m_alive[game] && m_loops[game].isEnabled()) {
+            m_loops[game].repeated(m_direction[game]); /* the first state can not be a repeat */
+        }
+        if (!m_alive[game]) {
+            m_episode[game] = EpisodeResult{seed, m_score[game], m_totalSteps[game], m_eatSteps[game], StepResult(m_last[game])};
+        }
+    }
+
+    void VecEnv::step(const int8_t *directions) {
+        // the direction and next head cell of every game, -1 off the board
+        for (int i = 0; i < m_gameNum; i++) {
+            const int8_t d = directions[i] != 0 ? directions[i] : m_direction[i];
+            const Delta &delta = c_moveDelta[d + 2];
+            const int row = m_headRow[i] + delta.row;
+            const int col = m_headCol[i] + delta.col;
+            const bool inBound = unsigned(row) < unsigned(m_row) && unsigned(col) < unsigned(m_col);
+
+            m_direction[i] = d;
+            m_target[i] = inBound ? row * m_col + col : -1;
+            m_done[i] = m_alive[i];
+        }
+
+        for (int i = 0; i < m_gameNum; i++) {
+            move(i, m_target[i]);
+        }
+
+        // wander and loop check and rewards
+        for (int i = 0; i < m_gameNum; i++) {
+            const bool wandered = m_alive[i] && m_totalSteps[i] - m_eatSteps[i] > m_wanderThreshold;
+            const bool looped = m_alive[i] && !wandered && m_loops[i].isEnabled() && m_loops[i].repeated(m_direction[i]);
+            const uint8_t last = wandered ? uint8_t(StepResult::wandered) : (looped ? uint8_t(StepResult::looped) : m_last[i]);
+            const bool ate = last == StepResult::ate || last == StepResult::perfect;
+
+            if (looped) {
+                m_totalSteps[i] = m_eatSteps[i] + m_wanderThreshold + 1;
+            }
+            m_alive[i] = m_alive[i] && !wandered && !looped;
+            m_last[i] = last;
+            m_done[i] = m_done[i] && !m_alive[i];
+            m_reward[i] = ate ? 1.0f : (m_alive[i] ? 0.0f : -1.0f);
+        }
+
+        // the games that ended start over, unless the caller picks their next seed
+        std::uniform_int_distribution<unsigned int> dist(1, std::numeric_limits<int>::max());
+        for (int i = 0; i < m_gameNum; i++) {
+            if (m_done[i]) {
+                m_episode[i] = EpisodeResult{m_seed[i], m_score[i], m_totalSteps[i], m_eatSteps[i], StepResult(m_last[i])};
+                if (m_autoReset) {
+                    reset(i, dist(m_seedRng));
+                }
+            }
+        }
+    }
+
+    void VecEnv::move(int game, int target) {
+        // HeadlessGame::step past the direction
+        if (!m_alive[game]) {
+            return;
+        }
+
+        if (target < 0) {
+            m_alive[game] = 0;
+            m_last[game] = StepResult::hitWall;
+            return;
+        }
+
+        switch (m_cells[game * m_size + target]) {
+        case Cell::apple:
+            m_apple[game] = -1;
+            m_score[game]++;
+            m_totalSteps[game]++;
+            m_eatSteps[game] = m_totalSteps[game];
+            addHead(game, target);
+            m_loops[game].grow(target);
+
+            if (m_score[game] == m_size - 1) {
+                // perfect snake, R.I.P
+                m_alive[game] = 0;
+                m_last[game] = StepResult::perfect;
+                return;
+            }
+
+            m_last[game] = StepResult::ate;
+            placeApple(game);
+            break;
+
+        case Cell::empty:
+            m_loops[game].shift(target, removeTail(game));
+            addHead(game, target);
+            m_totalSteps[game]++;
+            m_last[game] = StepResult::moved;
+            break;
+
+        default:
+            m_alive[game] = 0;
+            m_last[game] = StepResult::biteSelf;
+            break;
+        }
+    }
+
+    void VecEnv::addHead(int game, int cell) {
+        const int base = game * m_size;
+
+        m_bodyHead[game] = (m_bodyHead[game] == 0 ? m_size : m_bodyHead[game]) - 1;
+        m_body[base + m_bodyHead[game]] = cell;
+        m_length[game]++;
+
+        m_cells[base + cell] = Cell::snake;
+        takeCell(game, cell);
+        m_planes[game * m_wordNum + (cell >> 6)] |= uint64_t(1) << (cell & 63);
+        m_headRow[game] = cell / m_col;
+        m_headCol[game] = cell % m_col;
+    }
+
+    int VecEnv::removeTail(int game) {
+        const int base = game * m_size;
+
+        int tail = m_bodyHead[game] + m_length[game] - 1;
+        if (tail >= m_size) {
+            tail -= m_size;
+        }
+
+        const int cell = m_body[base + tail];
+        m_cells[base + cell] = Cell::empty;
+        freeCell(game, cell);
+        m_planes[game * m_wordNum + (cell >> 6)] &= ~(uint64_t(1) << (cell & 63));
+        m_length[game]--;
+
+        return cell;
+    }
+
+    void VecEnv::placeApple(int game) {
+        // PlayboardModel::getRandomEmptyPosition
+        const int base = game * m_size;
+        const int cell = m_freeCells[base + randomNumber(game, 0, m_freeNum[game] - 1)];
+
+        m_apple[game] = cell;
+        m_cells[base + cell] = Cell::apple;
+        takeCell(game, cell);
+    }
+
+    void VecEnv::freeCell(int game, int cell) {
+        // FreeCellSet::insert
+        const int base = game * m_size;
+        if (m_freeSlot[base + cell] >= 0) {
+            return;
+        }
+        m_freeSlot[base + cell] = m_freeNum[game];
+        m_freeCells[base + m_freeNum[game]++] = cell;
+    }
+
+    void VecEnv::takeCell(int game, int cell) {
+        // FreeCellSet::erase
+        const int base = game * m_size;
+        const int slot = m_freeSlot[base + cell];
+        if (slot < 0) {
+            return;
+        }
+        const int last = m_freeCells[base + --m_freeNum[game]];
+        m_freeCells[base + slot] = last;
+        m_freeSlot[base + last] = slot;
+        m_freeSlot[base + cell] = -1;
+    }
+
+    void VecEnv::buildInputs(double *inputs) const {
+        for (int i = 0; i < m_gameNum; i++) {
+            buildInput(i, inputs + i * c_inputSize);
+        }
+    }
+
+    void VecEnv::buildInput(int game, double *input) const {
+        // HeadlessGame::buildInput
+        const int head = m_headRow[game] * m_col + m_headCol[game];
+        const BitboardView plane(&m_planes[game * m_wordNum]);
+
+        int appleDistance = -1;
+        const int appleRay = m_apple[game] >= 0 ? m_rays->rayTo(head, m_apple[game], appleDistance) : -1;
+
+        double *vision = input;
+        for (int ray = 0; ray < RayTable::c_rayNum; ray++) {
+            *vision++ = m_wallValue[m_rays->wallDistance(head, ray) + 1];
+            *vision++ = m_bodyValue[m_rays->nearest(plane, head, ray) + 1];
+            *vision++ = m_foodValue[(ray == appleRay ? appleDistance : -1) + 1];
+        }
+
+        std::copy_n(c_directionVector[m_direction[game] + 2], c_directionSize, input + c_visionSize);
+    }
+
+} // namespace sim
@@ -3,7 +3,6 @@
 #include "FPSTimer.h"
 #include <glog/logging.h>
 
-#include "AppConfig.h"
 #include "SnakeModel.h"
 #include <chrono>
 #include <fmt/core.h>
@@ -16,7 +15,9 @@ using namespace std;
 
 DECLARE_int64(mode);
 
-SnakeApp::SnakeApp() {
+SnakeApp::SnakeApp() : SnakeApp(GameSettings::capture()) {}
+
+SnakeApp::SnakeApp(std::shared_ptr<const GameSettings> settings) : m_settings(std::move(settings)) {
     state = SnakeAppState(SnakeAppState::init);
 
     m_snake = nullptr;
@@ -45,6 +46,23 @@ int SnakeApp::start() {
     return 0;
 }
 
+bool SnakeApp::runTrainSlice(int maxSteps) {
+
+    if (!state.isRunning() && !state.isEnd()) {
+        setState(SnakeAppState::running);
+    }
+
+    for (int step = 0; running && (maxSteps <= 0 || step < maxSteps); step++) {
+        onUpdate();
+    }
+
+    if (!running) {
+        onCleanup();
+    }
+
+    return !running;
+}
+
 void SnakeApp::setMaxFrameRate(int framerate) {
     m_maxFrameRate = framerate;
     m_frameDuration = 1000 / m_maxFrameRate;
@@ -58,12 +76,12 @@ void SnakeApp::setDefaults() {
 
 void SnakeApp::initModels() {
 
-    m_playboard = std::make_shared<PlayboardModel>(AppConfig::PlayboardRowNum(), AppConfig::PlayboardColNum());
-    m_snake = std::make_shared<SnakeModel>();
+    m_playboard = std::make_shared<PlayboardModel>(m_settings);
+    m_snake = std::make_shared<SnakeModel>(m_settings);
 
     m_snake->setPlayboardForBrain(m_playboard);
 
-    if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+    if (!m_settings->runMode.isTrainMode()) {
         // human mode or AI mode
         // init UI related models
         m_infoboard = std::make_shared<InfoboardModel>();
@@ -74,8 +92,8 @@ void SnakeApp::initModels() {
         m_infoboard->addObserver(*m_UIManager);
         m_playboard->addObserver(*m_UIManager);
 
-        m_snake->addObserver(*m_infoboard);
-        m_snake->addObserver(*m_UIManager);
+        m_snake->addObserver(*m_infoboard, {SnakeEvent::score, SnakeEvent::refreshTime, SnakeEvent::direction, SnakeEvent::stepCount, SnakeEvent::nextDirection, SnakeEvent::state});
+        m_snake->addObserver(*m_UIManager, {SnakeEvent::addHeadBlock, SnakeEvent::removeTailBlock, SnakeEvent::nextDirection});
         this->addObserver(*m_infoboard);
 
         m_UIManager->addObserver(*this);
@@ -86,8 +104,9 @@ void SnakeApp::initModels() {
         });
     }
 
+    // the events each model handles, the others never reach it
     m_playboard->addObserver(*m_snake);
-    m_snake->addObserver(*m_playboard);
+    m_snake->addObserver(*m_playboard, {SnakeEvent::move, SnakeEvent::addHeadBlock, SnakeEvent::removeTailBlock, SnakeEvent::eat});
 
     m_snake->initSnake();
     m_playboard->initPlayboard();
@@ -97,14 +116,14 @@ void SnakeApp::runLoop() {
 
     setState(SnakeAppState::running);
 
-    if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+    if (!m_settings->runMode.isTrainMode()) {
         m_snake->setLastMoveTime(std::chrono::high_resolution_clock::now());
         m_fpsTimer->reset();
     }
 
     while (running) {
 
-        if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+        if (!m_settings->runMode.isTrainMode()) {
 
             auto start = std::chrono::high_resolution_clock::now();
             onEvent();
@@ -134,13 +153,13 @@ void SnakeApp::onUpdate() {
     // update models
     m_playboard->update();
 
-    if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+    if (!m_settings->runMode.isTrainMode()) {
         m_infoboard->update();
     }
 
     if (m_snake->getState().isDie() && state.isRunning()) {
         /* game should end */
-        if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+        if (!m_settings->runMode.isTrainMode()) {
             m_snake->pause();
             setState(SnakeAppState::end);
         } else {
@@ -151,7 +170,7 @@ void SnakeApp::onUpdate() {
 
     m_snake->update();
 
-    if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+    if (!m_settings->runMode.isTrainMode()) {
         m_UIManager->update();
     }
 }
@@ -159,40 +178,40 @@ void SnakeApp::onUpdate() {
 void SnakeApp::onRender() { m_UIManager->onRender(); }
 
 void SnakeApp::onCleanup() {
-    if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+    if (!m_settings->runMode.isTrainMode()) {
         m_UIManager->onCleanup();
     }
 }
 
 void SnakeApp::onExit() { running = false; }
 
-void SnakeApp::field_changed([[maybe_unused]] UIManager &source, const string &field_name) {
-    if (field_name == "quit") {
+void SnakeApp::field_changed([[maybe_unused]] UIManager &source, UIEvent::Type event) {
+    if (event == UIEvent::quit) {
 
         onExit();
 
-    } else if (field_name == "down") {
-        if (AppConfig::RunMode().isHumanMode()) { m_snake->setDirection(SnakeDirection::down); }
-    } else if (field_name == "up") {
-        if (AppConfig::RunMode().isHumanMode()) { m_snake->setDirection(SnakeDirection::up); }
-    } else if (field_name == "right") {
-        if (AppConfig::RunMode().isHumanMode()) { m_snake->setDirection(SnakeDirection::right); }
-    } else if (field_name == "left") {
-        if (AppConfig::RunMode().isHumanMode()) { m_snake->setDirection(SnakeDirection::left); }
+    } else if (event == UIEvent::down) {
+        if (m_settings->runMode.isHumanMode()) { m_snake->setDirection(SnakeDirection::down); }
+    } else if (event == UIEvent::up) {
+        if (m_settings->runMode.isHumanMode()) { m_snake->setDirection(SnakeDirection::up); }
+    } else if (event == UIEvent::right) {
+        if (m_settings->runMode.isHumanMode()) { m_snake->setDirection(SnakeDirection::right); }
+    } else if (event == UIEvent::left) {
+        if (m_settings->runMode.isHumanMode()) { m_snake->setDirection(SnakeDirection::left); }
 
-    } else if (field_name == "onPKeyPressed") {
+    } else if (event == UIEvent::onPKeyPressed) {
 
         if (state.isRunning()) {
             setState(SnakeAppState::pause);
             m_snake->pause();
         }
 
-    } else if (field_name == "onQKeyPressed") {
+    } else if (event == UIEvent::onQKeyPressed) {
         if (state.isEnd()) {
             onExit();
         }
 
-    } else if (field_name == "onRKeyPressed") {
+    } else if (event == UIEvent::onRKeyPressed) {
         if (state.isPause()) {
             setState(SnakeAppState::running);
             m_snake->resume();
@@ -209,7 +228,7 @@ void SnakeApp::field_changed([[maybe_unused]] UIManager &source, const string &f
             setState(SnakeAppState::running);
         }
 
-    } else if (field_name == "onSpacePressed") {
+    } else if (event == UIEvent::onSpacePressed) {
         m_snake->setManualToggle(!(m_snake->getManualToggle()));
 
     } else {
@@ -8,6 +8,7 @@
 #include <glog/logging.h>
 
 #include "PlayboardModel.h"
+#include "Simulation/Vision.h"
 #include <fmt/core.h>
 #include <fmt/ranges.h>
 #include <limits>
@@ -70,6 +71,10 @@ SnakeBrain::SnakeBrain() {
         initLayerActivateType();
     }
 
+    if (m_nn) {
+        m_output.resize(m_nn->getTopology().back());
+    }
+
     if (AppConfig::RunMode().isHumanMode()) {
         m_nn = nullptr;
     }
@@ -78,33 +83,43 @@ SnakeBrain::~SnakeBrain() {
 }
 
 SnakeDirection SnakeBrain::think(std::vector<double> &input) {
+    return think(input.data(), input.size());
+}
+
+SnakeDirection SnakeBrain::think(const double *input, int inputSize) {
 
-    m_nn->setInput(input);
+    m_nn->setInput(input, inputSize);
     m_nn->feedForward();
 
-    std::shared_ptr<std::vector<double>> outputLayerActivateValues = m_nn->activatedValVectorOfLayerAt(m_nn->getTopology().size() - 1);
+    const auto &topology = m_nn->getTopology();
+    m_output.resize(topology.back());
+    m_nn->activatedValuesOfLayerAt(topology.size() - 1, m_output.data());
+    return directionOf(m_output.data(), m_output.size());
+}
+
+SnakeDirection SnakeBrain::directionOf(const double *output, int outputSize) {
+
     constexpr double lowest_double = std::numeric_limits<double>::lowest();
 
     double max = lowest_double;
     int maxIndex = -1;
-    int outputSize = outputLayerActivateValues->size();
 
     for (int i = 0; i < outputSize; i++) {
-        if (outputLayerActivateValues->at(i) >= max) {
-            max = outputLayerActivateValues->at(i);
+        if (output[i] >= max) {
+            max = output[i];
             maxIndex = i;
         }
     }
 
-    double up = outputLayerActivateValues->at(0);
-    double right = outputLayerActivateValues->at(1);
-    double down = outputLayerActivateValues->at(2);
-    double left = outputLayerActivateValues->at(3);
+    double up = output[0];
+    double right = output[1];
+    double down = output[2];
+    double left = output[3];
 
     if ((up == 0 && right == 0 && down == 0 && left == 0) || (up == 1 && right == 1 && down == 1 && left == 1)) {
 
         LOG(ERROR) << "Output layer value abnorml, return invalid direction";
-        std::string outputLayerValueLog = fmt::format("outputLayerActivateValues = {}.", *outputLayerActivateValues);
+        std::string outputLayerValueLog = fmt::format("outputLayerActivateValues = {}.", std::vector<double>(output, output + outputSize));
         LOG(ERROR) << outputLayerValueLog;
 
         return SnakeDirection::invalid;
@@ -125,7 +140,7 @@ SnakeDirection SnakeBrain::think(std::vector<double> &input) {
 
         default:
             LOG(ERROR) << "maxIndex is out of range, should never see this log.";
-            std::string outputLayerValueLog = fmt::format("max = {}, outputLayerActivateValues = {}.", max, *outputLayerActivateValues);
+            std::string outputLayerValueLog = fmt::format("max = {}, outputLayerActivateValues = {}.", max, std::vector<double>(output, output + outputSize));
             LOG(ERROR) << outputLayerValueLog;
 
             return SnakeDirection::invalid;
@@ -134,7 +149,7 @@ SnakeDirection SnakeBrain::think(std::vector<double> &input) {
     } else {
 
         LOG(ERROR) << "should never see this log, maxIndex value = " << maxIndex;
-        std::string outputLayerValueLog = fmt::format("max = {}, outputLayerActivateValues = {}.", max, *outputLayerActivateValues);
+        std::string outputLayerValueLog = fmt::format("max = {}, outputLayerActivateValues = {}.", max, std::vector<double>(output, output + outputSize));
         LOG(ERROR) << outputLayerValueLog;
 
         return SnakeDirection::invalid;
@@ -198,74 +213,18 @@ void SnakeBrain::setPlayboardModel(std::shared_ptr<PlayboardModel> &playboard) {
 void SnakeBrain::buildVisionVector(std::vector<double> &visionVector,
                                    const BlockPosition &head,
                                    [[maybe_unused]] const BlockPosition &apple,
-                                   const int row, [[maybe_unused]] const int col) {
-
-    int index = 0;
-    for_each(SnakeBrain::visionChangeList.begin(), SnakeBrain::visionChangeList.end(), [this, &visionVector, &head, row, &index](const auto &v) {
-        double wallValue = 0.0, bodyValue = 0.0, foodValue = 0.0;
-        int wallDistance = -1, bodyDistance = -1, foodDistance = -1;
+                                   const int row, const int col) {
 
-        int tempRow = head.row;
-        int tempCol = head.col;
+    auto p = m_playboard.lock();
+    double vision[sim::c_visionSize];
 
-        int wallStep = 1;
-        int foodStep = 0;
-        int snakeStep = 0;
-
-        auto p = m_playboard.lock();
-        while (tempRow += v[0], tempCol += v[1], p->isWithinBound(BlockPosition{tempRow, tempCol})) {
-
-            if (p->isSnake(tempRow, tempCol) && bodyDistance == -1) {
-                bodyDistance = snakeStep;
-            }
-
-            if (p->isApple(tempRow, tempCol) && foodDistance == -1) {
-                foodDistance = foodStep;
-            }
-
-            wallDistance = wallStep;
-
-            wallStep++;
-            foodStep++;
-            snakeStep++;
-        }
+    sim::walkVision(
+        head.row, head.col, row, col,
+        [&p](int r, int c) { return p->isSnake(r, c); },
+        [&p](int r, int c) { return p->isApple(r, c); },
+        vision);
 
-        if (wallDistance == -1) {
-            wallDistance = 0;
-        }
-
-        wallValue = SnakeBrain::wallValue(wallDistance, row);
-        bodyValue = SnakeBrain::bodyValue(bodyDistance, row);
-        foodValue = SnakeBrain::foodValue(foodDistance, row);
-
-        std::vector<double> d{wallValue, bodyValue, foodValue};
-        visionVector.insert(visionVector.end(), d.begin(), d.end());
-
-        index++;
-    });
-}
-
-double SnakeBrain::wallValue(const double wallDistance, const int totalBlockSize) {
-    return wallDistance / double(totalBlockSize - 1);
-}
-
-double SnakeBrain::bodyValue(const double bodyDistance, const int totalBlockSize) {
-
-    if (-1 == bodyDistance) {
-        //该方向上没有蛇身
-        return 1.0;
-    } else {
-        return bodyDistance / double(totalBlockSize - 1.0);
-    }
-}
-
-double SnakeBrain::foodValue(const double foodDistance, const int totalBlockSize) {
-    if (-1 == foodDistance) {
-        //该方向上没有苹果
-        return 0.0;
-    } else {
-        return (totalBlockSize - foodDistance - 1.0) / (totalBlockSize - 1.0);
-    }
+    visionVector.insert(visionVector.end(), vision, vision + sim::c_visionSize);
 }
 
 SnakeDirection SnakeBrain::randomDirection() {
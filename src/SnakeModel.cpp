@@ -5,13 +5,13 @@
 #include <limits>
 #include <memory>
 
-#include "AppConfig.h"
 #include "NeuralNetwork/NeuralNetwork.h"
 #include "SnakeApp.h"
 #include "SnakeBrain.h"
+#include "Simulation/Fitness.h"
 #include "Utility.h"
 
-SnakeModel::SnakeModel() {
+SnakeModel::SnakeModel(std::shared_ptr<const GameSettings> settings) : m_settings(std::move(settings)) {
     setStateInfo(" ");
     setState(SnakeState::alive);
     setScore(0);
@@ -36,9 +36,9 @@ void SnakeModel::initSnake() {
     while (d = utility::random::generateRandomNumber(-2, 2), d == 0)
         ;
 
-    int offset = int(AppConfig::PlayboardRowNum() * 0.3); /* make the snake not closer to the bound */
-    row = utility::random::generateRandomNumber(offset, AppConfig::PlayboardRowNum() - offset);
-    col = utility::random::generateRandomNumber(offset, AppConfig::PlayboardColNum() - offset);
+    int offset = int(m_settings->row * 0.3); /* make the snake not closer to the bound */
+    row = utility::random::generateRandomNumber(offset, m_settings->row - offset);
+    col = utility::random::generateRandomNumber(offset, m_settings->col - offset);
 
     setDirection(SnakeDirection(d));
     setNextDirection(SnakeDirection::invalid);
@@ -52,9 +52,15 @@ void SnakeModel::initSnake() {
     setDefaultMoveInterval();
 }
 
-void SnakeModel::update() {
+template <AppRunMode::Mode mode>
+void SnakeModel::updateIn() {
+    using Rules = ModeRules<mode>;
+
+    if (!getState().isAlive()) {
+        return;
+    }
 
-    if ((AppConfig::RunMode().isAIMode() || AppConfig::RunMode().isHumanMode()) && getState().isAlive()) {
+    if constexpr (Rules::interactive) {
 
         auto now = std::chrono::high_resolution_clock::now();
         auto elapse = now - m_lastMoveTime;
@@ -63,13 +69,13 @@ void SnakeModel::update() {
             return;
         }
 
-        if (AppConfig::RunMode().isHumanMode() && getState().isAlive()) {
+        if constexpr (mode == AppRunMode::human) {
             this->playStep();
         }
 
-        if (AppConfig::RunMode().isAIMode() && getState().isAlive()) {
+        if constexpr (mode == AppRunMode::ai) {
 
-            if (AppConfig::PlayManually()) {
+            if (m_settings->playManually) {
 
                 if (getManualToggle()) {
 
@@ -107,27 +113,13 @@ void SnakeModel::update() {
         }
 
         setLastMoveTime(std::chrono::high_resolution_clock::now());
-    }
 
-    if (AppConfig::RunMode().isTrainMode() && getState().isAlive()) {
+    } else {
         this->playStep();
 
-        int stuckedThreshold = 0;
-        const int initSnakeLen = 1;
-        const int strictThreshold = AppConfig::PlayboardSize() - initSnakeLen;
-
-        if (AppConfig::StrictWander()) {
-            stuckedThreshold = strictThreshold;
-        } else {
-            stuckedThreshold = AppConfig::WanderThreshold();
-            if (stuckedThreshold < strictThreshold) {
-                stuckedThreshold = strictThreshold;
-            }
-        }
-
         int totalStep = getTotalStepCount();
         int eatStep = getEatStepCount();
-        if (totalStep - eatStep > stuckedThreshold) {
+        if (totalStep - eatStep > m_settings->wanderThreshold) {
             setState(SnakeState::die);
             return;
         }
@@ -139,45 +131,36 @@ void SnakeModel::update() {
     }
 }
 
+void SnakeModel::update() {
+    // the mode is fixed for the run, branch on it once per update
+    switch (m_settings->runMode) {
+    case AppRunMode::human:
+        updateIn<AppRunMode::human>();
+        break;
+    case AppRunMode::ai:
+        updateIn<AppRunMode::ai>();
+        break;
+    case AppRunMode::train:
+        updateIn<AppRunMode::train>();
+        break;
+    }
+}
+
 void SnakeModel::setMoveInterval(int interval) {
     m_moveInterval = interval;
-    this->notify(*this, "refreshTime");
+    this->notify(*this, SnakeEvent::refreshTime);
 }
 
 void SnakeModel::decreaseMoveInterval() {
 
-    auto curr_refresh_time = std::max(AppConfig::InitInterval() - getScore() * AppConfig::IntervalStep(), /* speed up with score increase */
-                                      AppConfig::MinInterval() /* min speed */);
+    auto curr_refresh_time = std::max(m_settings->initInterval - getScore() * m_settings->intervalStep, /* speed up with score increase */
+                                      m_settings->minInterval /* min speed */);
 
     setMoveInterval(curr_refresh_time);
 }
 
 void SnakeModel::fitness() {
-
-    long double d = 100000.0;
-    long double rewardScoreAndExplore = m_score + 0.5 + (0.5 * (m_totalStepCount - (m_totalStepCount / (m_score + 1.0))) / (m_totalStepCount + (m_totalStepCount / (m_score + 1.0))));
-
-#if 1
-    // reward lessAvgStep make the snake less wander, just go strait for apple as much as possible.
-    // these paramters is tuned for 10x10 playboard
-    // need adjust if training snake in other size,
-    double exponentStart = 1.9;
-    double delta = m_score / 10 * 0.03;
-    double exponent = exponentStart - delta;
-    long double rewardLessAvgStep = (1.0 / (m_totalStepCount / (m_score + 1.0))) * pow(rewardScoreAndExplore + 0.5, exponent);
-    m_rank = rewardScoreAndExplore + rewardLessAvgStep;
-#else
-    // simple and fast
-    // but the totalsteps will be large.
-    m_rank = rewardScoreAndExplore;
-#endif
-    m_rank *= d;
-
-    long double max = std::numeric_limits<long double>::max();
-    if (m_rank > max) {
-        fmt::print("m_rank is big than max {}\n", max);
-        m_rank = max;
-    }
+    m_rank = sim::fitness(m_score, m_totalStepCount);
 }
 
 void SnakeModel::setPlayboardForBrain(std::shared_ptr<PlayboardModel> &playboard) {
@@ -192,23 +175,23 @@ void SnakeModel::playStep() {
         move();
     }
 
-    this->notify(*this, "playStep");
+    this->notify(*this, SnakeEvent::playStep);
 }
 
 void SnakeModel::move() {
 
     BlockPosition currHeadPos = m_snakeBodyQueue.front().getPosition();
-    BlockPosition nextHeadPos = currHeadPos.nextPositionOfDirection(SnakeDirection::changeMap[getCurrentDirection().rawValue()]);
+    BlockPosition nextHeadPos = currHeadPos.nextPositionOfDirection(getCurrentDirection().toChange());
 
     setNextHeadPostion(nextHeadPos);
 
-    this->notify(*this, "move");
+    this->notify(*this, SnakeEvent::move);
 }
 
 void SnakeModel::addHeadBlock() {
 
     m_snakeBodyQueue.push_front(SnakeBlock(m_nextHeadPosition));
-    this->notify(*this, "addHeadBlock");
+    this->notify(*this, SnakeEvent::addHeadBlock);
 }
 
 void SnakeModel::removeTailBlock() {
@@ -216,7 +199,7 @@ void SnakeModel::removeTailBlock() {
     m_removedTailPostion = m_snakeBodyQueue.back().getPosition();
     m_snakeBodyQueue.pop_back();
 
-    this->notify(*this, "removeTailBlock");
+    this->notify(*this, SnakeEvent::removeTailBlock);
 }
 
 void SnakeModel::eat() {
@@ -225,20 +208,20 @@ void SnakeModel::eat() {
     increaseTotalStep();
     setEatStepCount(getTotalStepCount());
 
-    if (AppConfig::RunMode().isHumanMode() || AppConfig::RunMode().isAIMode()) {
+    if (!m_settings->runMode.isTrainMode()) {
         decreaseMoveInterval();
     }
 
     addHeadBlock();
 
-    if (getScore() == (AppConfig::PlayboardSize() - 1)) {
+    if (getScore() == (m_settings->size - 1)) {
         // perfect snake, R.I.P
         setStateInfo("Perfect Snake, R.I.P");
         setState(SnakeState::die);
         return;
     }
 
-    this->notify(*this, "eat");
+    this->notify(*this, SnakeEvent::eat);
 }
 
 void SnakeModel::forward() {
@@ -247,7 +230,7 @@ void SnakeModel::forward() {
 
     increaseTotalStep();
 
-    this->notify(*this, "forward");
+    this->notify(*this, SnakeEvent::forward);
 }
 
 void SnakeModel::reset() {
@@ -269,9 +252,9 @@ void SnakeModel::buildNeuralNetworkInputVector(std::vector<double> &input) {
     BlockPosition headPosition = m_snakeBodyQueue.front().getPosition();
     const int visionSize = 24;
 
-    m_brain->buildVisionVector(input, headPosition, m_applePosition, AppConfig::PlayboardRowNum(), AppConfig::PlayboardColNum());
+    m_brain->buildVisionVector(input, headPosition, m_applePosition, m_settings->row, m_settings->col);
 
-    std::vector<double> direction = this->getCurrentDirection().toVector();
+    std::array<double, 4> direction = this->getCurrentDirection().toArray();
     input.insert(input.begin() + visionSize, direction.begin(), direction.end());
 }
 
@@ -281,12 +264,13 @@ SnakeDirection SnakeModel::thinking() {
     const int directionSize = 4;
     const int inputSize = visionSize + directionSize;
 
-    std::vector<double> input(inputSize);
-    input.clear();
+    // kept between steps, no allocation once it has grown
+    m_input.reserve(inputSize);
+    m_input.clear();
 
-    this->buildNeuralNetworkInputVector(input);
+    this->buildNeuralNetworkInputVector(m_input);
 
-    SnakeDirection predictDirection = m_brain->think(input);
+    SnakeDirection predictDirection = m_brain->think(m_input);
     if (predictDirection != SnakeDirection::invalid) {
         return predictDirection;
     } else {
@@ -295,13 +279,13 @@ SnakeDirection SnakeModel::thinking() {
     }
 }
 
-void SnakeModel::field_changed(PlayboardModel &source, const string &field_name) {
+void SnakeModel::field_changed(PlayboardModel &source, PlayboardEvent::Type event) {
 
-    if (field_name == "placeApple") {
+    if (event == PlayboardEvent::placeApple) {
 
         m_applePosition = source.getApplePosition();
 
-    } else if (field_name == "eraseApple") {
+    } else if (event == PlayboardEvent::eraseApple) {
 
         m_applePosition.row = 0;
         m_applePosition.col = 0;
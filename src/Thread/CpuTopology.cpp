@@ -0,0 +1,234 @@
+#include "Thread/CpuTopology.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fmt/core.h>
+#include <fmt/ranges.h>
+#include <fstream>
+#include <glog/logging.h>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <tuple>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+
+    int readIntFile(const std::string &path, int fallback) {
+        std::ifstream i(path);
+        int value = fallback;
+        if (!(i >> value)) {
+            return fallback;
+        }
+        return value;
+    }
+
+    // parent directories of a cgroup path, the cgroup itself first
+    std::vector<std::string> cgroupDirs(const std::string &mount, const std::string &path) {
+        std::vector<std::string> dirs;
+        std::string p = path;
+        while (true) {
+            dirs.push_back(mount + (p == "/" ? "" : p));
+            if (p.empty() || p == "/") {
+                break;
+            }
+            auto pos = p.find_last_of('/');
+            p = (pos == 0 || pos == std::string::npos) ? "/" : p.substr(0, pos);
+        }
+        return dirs;
+    }
+
+    // cpu quota in number of cpus, the tightest limit along the hierarchy
+    double readCgroupQuota() {
+        double quota = 0;
+        auto tighten = [&quota](double q) {
+            if (q > 0 && (quota <= 0 || q < quota)) {
+                quota = q;
+            }
+        };
+
+        std::ifstream cgroup("/proc/self/cgroup");
+        std::string line;
+        while (std::getline(cgroup, line)) {
+            // hierarchy-ID:controller-list:cgroup-path
+            auto first = line.find(':');
+            auto second = line.find(':', first + 1);
+            if (first == std::string::npos || second == std::string::npos) {
+                continue;
+            }
+            std::string controllers = line.substr(first + 1, second - first - 1);
+            std::string path = line.substr(second + 1);
+
+            if (controllers.empty()) {
+                // cgroup v2, cpu.max is "max 100000" or "<quota> <period>"
+                for (const auto &dir : cgroupDirs("/sys/fs/cgroup", path)) {
+                    std::ifstream i(dir + "/cpu.max");
+                    std::string q;
+                    long period = 0;
+                    if (i >> q >> period && q != "max" && period > 0) {
+                        tighten(std::stod(q) / period);
+                    }
+                }
+                continue;
+            }
+
+            std::stringstream ss(controllers);
+            std::string controller;
+            bool hasCpu = false;
+            while (std::getline(ss, controller, ',')) {
+                hasCpu |= (controller == "cpu");
+            }
+            if (!hasCpu) {
+                continue;
+            }
+
+            // cgroup v1, cfs quota of -1 means unlimited
+            for (const std::string mount : {"/sys/fs/cgroup/cpu,cpuacct", "/sys/fs/cgroup/cpu"}) {
+                for (const auto &dir : cgroupDirs(mount, path)) {
+                    int q = readIntFile(dir + "/cpu.cfs_quota_us", -1);
+                    int period = readIntFile(dir + "/cpu.cfs_period_us", 0);
+                    if (q > 0 && period > 0) {
+                        tighten(double(q) / period);
+                    }
+                }
+            }
+        }
+
+        return quota;
+    }
+
+} // namespace
+
+ThreadAffinity ThreadAffinity::fromString(const std::string &name) {
+    if (name == "compact") {
+        return compact;
+    }
+    if (name == "scatter") {
+        return scatter;
+    }
+    if (!name.empty() && name != "none") {
+        LOG(WARNING) << fmt::format("Unknown threadAffinity '{}', workers are not pinned. accepted: none/compact/scatter", name);
+    }
+    return none;
+}
+
+CpuTopology CpuTopology::detect() {
+    CpuTopology t;
+    t.m_hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (0 == sched_getaffinity(0, sizeof(set), &set)) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (!CPU_ISSET(cpu, &set)) {
+                continue;
+            }
+            std::string dir = fmt::format("/sys/devices/system/cpu/cpu{}/topology/", cpu);
+            t.m_cpus.push_back(CpuInfo{cpu,
+                                       readIntFile(dir + "core_id", cpu),
+                                       readIntFile(dir + "physical_package_id", 0)});
+        }
+    }
+
+    t.m_cpuQuota = readCgroupQuota();
+#endif
+
+    if (t.m_cpus.empty()) {
+        for (int cpu = 0; cpu < t.m_hardwareThreads; cpu++) {
+            t.m_cpus.push_back(CpuInfo{cpu, cpu, 0});
+        }
+    }
+
+    return t;
+}
+
+int CpuTopology::effectiveCpuNum() const {
+    int num = allowedCpuNum();
+    if (m_cpuQuota > 0) {
+        // round down, a fractional cpu is exactly what gets throttled
+        num = std::min(num, std::max(1, int(std::floor(m_cpuQuota))));
+    }
+    return std::max(1, num);
+}
+
+std::vector<int> CpuTopology::pinOrder(ThreadAffinity affinity, int threadNum) const {
+    std::vector<int> order;
+    if (affinity == ThreadAffinity::none || m_cpus.empty()) {
+        return order;
+    }
+
+    std::vector<CpuInfo> cpus = m_cpus;
+    std::sort(cpus.begin(), cpus.end(), [](const CpuInfo &a, const CpuInfo &b) {
+        return std::tie(a.package, a.core, a.cpu) < std::tie(b.package, b.core, b.cpu);
+    });
+
+    std::vector<int> sequence;
+    if (affinity == ThreadAffinity::compact) {
+        for (const auto &c : cpus) {
+            sequence.push_back(c.cpu);
+        }
+    } else {
+        // siblings of a core, cores interleaved across packages
+        std::map<std::pair<int, int>, std::vector<int>> siblings; // (package, core) -> cpus
+        std::map<int, std::vector<int>> packageCores;              // package -> cores
+        for (const auto &c : cpus) {
+            auto &s = siblings[{c.package, c.core}];
+            if (s.empty()) {
+                packageCores[c.package].push_back(c.core);
+            }
+            s.push_back(c.cpu);
+        }
+
+        size_t maxCores = 0, maxSiblings = 0;
+        for (const auto &p : packageCores) {
+            maxCores = std::max(maxCores, p.second.size());
+        }
+        for (const auto &s : siblings) {
+            maxSiblings = std::max(maxSiblings, s.second.size());
+        }
+
+        for (size_t rank = 0; rank < maxSiblings; rank++) {
+            for (size_t coreIndex = 0; coreIndex < maxCores; coreIndex++) {
+                for (const auto &p : packageCores) {
+                    if (coreIndex >= p.second.size()) {
+                        continue;
+                    }
+                    const auto &s = siblings[{p.first, p.second[coreIndex]}];
+                    if (rank < s.size()) {
+                        sequence.push_back(s[rank]);
+                    }
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < threadNum; i++) {
+        order.push_back(sequence[i % sequence.size()]);
+    }
+
+    return order;
+}
+
+std::string CpuTopology::description() const {
+    std::map<int, int> packages;
+    std::map<std::pair<int, int>, int> cores;
+    std::vector<int> ids;
+    for (const auto &c : m_cpus) {
+        packages[c.package]++;
+        cores[{c.package, c.core}]++;
+        ids.push_back(c.cpu);
+    }
+
+    return fmt::format("hardware threads = {}, allowed cpus = {} {}, packages = {}, physical cores = {}, cpu quota = {}, effective cpus = {}",
+                       m_hardwareThreads,
+                       allowedCpuNum(),
+                       ids,
+                       packages.size(),
+                       cores.size(),
+                       m_cpuQuota > 0 ? fmt::format("{:.2f}", m_cpuQuota) : std::string("none"),
+                       effectiveCpuNum());
+}
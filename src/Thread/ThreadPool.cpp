@@ -1,71 +1,269 @@
 #include "Thread/ThreadPool.h"
 #include <fmt/core.h>
 #include <fmt/ranges.h>
+#include <glog/logging.h>
 #include <thread>
 
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+    // which pool and worker the current thread belongs to, jobs queued from
+    // inside a job go to the worker's own deque.
+    thread_local ThreadPool *t_pool = nullptr;
+    thread_local uint32_t t_workerIndex = 0;
+} // namespace
+
 ThreadPool::ThreadPool() {
     const uint32_t num_threads = std::thread::hardware_concurrency(); // Max # of threads the system supports
-    threads.resize(num_threads);
-    for (uint32_t i = 0; i < num_threads; i++) {
-        threads.at(i) = std::thread(&ThreadPool::threadLoop, this);
+    start(num_threads);
+}
+
+ThreadPool::ThreadPool(uint32_t threadNum, const std::vector<int> &pinCpus) {
+    start(threadNum);
+
+    if (pinCpus.empty()) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < threads.size(); i++) {
+        int cpu = pinCpus[i % pinCpus.size()];
+        if (!pinThread(threads[i], cpu)) {
+            LOG(WARNING) << fmt::format("ThreadPool pin worker {} to cpu {} failed, worker left unpinned", i, cpu);
+            cpu = -1;
+        }
+        pinned_cpus.push_back(cpu);
     }
 }
 
 ThreadPool::~ThreadPool() {
+    done();
     threads.clear();
 }
 
+void ThreadPool::start(uint32_t threadNum) {
+    const uint32_t num_threads = std::max(threadNum, 1u);
+
+    workers.reserve(num_threads);
+    for (uint32_t i = 0; i < num_threads; i++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+
+    threads.resize(num_threads);
+    for (uint32_t i = 0; i < num_threads; i++) {
+        threads.at(i) = std::thread(&ThreadPool::threadLoop, this, i);
+    }
+}
+
+bool ThreadPool::pinThread(std::thread &thread, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return 0 == pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+    // no portable affinity api, macOS only takes hints through thread_policy_set
+    (void)thread;
+    (void)cpu;
+    return false;
+#endif
+}
+
 void ThreadPool::done() {
 
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
+        std::unique_lock<std::mutex> lock(sleep_mutex);
         should_terminate = true;
     }
-    mutex_condition.notify_all();
+    sleep_condition.notify_all();
     for (std::thread &active_thread : threads) {
-        active_thread.join();
+        if (active_thread.joinable()) {
+            active_thread.join();
+        }
     }
 }
 
 void ThreadPool::join() {
-    /* TODO: wait all job finish */
+    std::unique_lock<std::mutex> lock(idle_mutex);
+    idle_condition.wait(lock, [this] {
+        return pending_jobs.load() == 0;
+    });
 }
 
-void ThreadPool::threadLoop() {
+void ThreadPool::threadLoop(uint32_t index) {
+    t_pool = this;
+    t_workerIndex = index;
+
     while (true) {
-        std::function<void()> job;
-
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex);
-            mutex_condition.wait(lock, [this] {
-                return !jobs.empty() || should_terminate;
-            });
-            if (should_terminate) {
-                return;
+        Task job;
+
+        if (popJob(index, job) || stealJob(index, job, false)) {
+            runJob(job);
+            continue;
+        }
+
+        // jobs are queued but every victim was locked: wait for the locks in
+        // turn this time, and give up the core before another round
+        if (queued_jobs.load() > 0) {
+            if (stealJob(index, job, true)) {
+                runJob(job);
+            } else {
+                std::this_thread::yield();
             }
+            continue;
+        }
 
-            job = jobs.front();
-            jobs.pop();
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        sleep_condition.wait(lock, [this] {
+            return queued_jobs.load() > 0 || should_terminate;
+        });
+        if (should_terminate) {
+            return;
         }
+    }
+}
 
-        job();
+bool ThreadPool::popJob(uint32_t index, Task &job) {
+    Worker &w = *workers[index];
+    std::unique_lock<std::mutex> lock(w.mutex);
+    if (w.jobs.empty()) {
+        return false;
     }
+
+    job = std::move(w.jobs.back());
+    w.jobs.pop_back();
+    queued_jobs--;
+    return true;
 }
 
-void ThreadPool::queueJob(const std::function<void()> &job) {
+bool ThreadPool::stealJob(uint32_t index, Task &job, bool wait) {
+    const uint32_t num = workers.size();
+    for (uint32_t i = 1; i < num; i++) {
+        Worker &victim = *workers[(index + i) % num];
+
+        std::unique_lock<std::mutex> lock(victim.mutex, std::defer_lock);
+        if (wait) {
+            lock.lock();
+        } else if (!lock.try_lock()) {
+            continue;
+        }
+        if (victim.jobs.empty()) {
+            continue;
+        }
+
+        job = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+        queued_jobs--;
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::runJob(Task &job) {
+    job();
+    job.reset();
+
+    if (pending_jobs.fetch_sub(1) == 1) {
+        std::unique_lock<std::mutex> lock(idle_mutex);
+        idle_condition.notify_all();
+    }
+}
+
+void ThreadPool::wakeWorkers(size_t count) {
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        jobs.push(job);
+        // empty critical section, a worker is either before its predicate check
+        // or already waiting when we notify.
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+    }
+
+    if (count == 1) {
+        sleep_condition.notify_one();
+    } else {
+        sleep_condition.notify_all();
     }
-    mutex_condition.notify_one();
 }
 
-bool ThreadPool::isBusy() {
-    bool poolbusy;
+uint32_t ThreadPool::submitIndex() {
+    if (t_pool == this) {
+        return t_workerIndex;
+    }
+    return next_worker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+}
+
+void ThreadPool::queueJob(Task job) {
+    pending_jobs++;
+
+    Worker &w = *workers[submitIndex()];
     {
-        std::unique_lock<std::mutex> lock(queue_mutex);
-        poolbusy = jobs.empty();
+        std::unique_lock<std::mutex> lock(w.mutex);
+        w.jobs.push_back(std::move(job));
+        queued_jobs++;
     }
 
-    return poolbusy;
+    wakeWorkers(1);
+}
+
+void ThreadPool::queueJobs(std::vector<Task> &jobs) {
+    const size_t total = jobs.size();
+    if (0 == total) {
+        return;
+    }
+
+    pending_jobs += total;
+
+    // deal contiguous slices to the workers, one lock per worker instead of one per job
+    const size_t num = workers.size();
+    const size_t first = submitIndex();
+    size_t begin = 0;
+    for (size_t i = 0; i < num && begin < total; i++) {
+        size_t count = total / num + (i < total % num ? 1 : 0);
+        Worker &w = *workers[(first + i) % num];
+
+        std::unique_lock<std::mutex> lock(w.mutex);
+        for (size_t j = begin; j < begin + count; j++) {
+            w.jobs.push_back(std::move(jobs[j]));
+        }
+        queued_jobs += count;
+        begin += count;
+    }
+
+    jobs.clear();
+    wakeWorkers(total);
+}
+
+bool ThreadPool::isBusy() {
+    return pending_jobs.load() > 0;
+}
+
+bool ThreadPool::ParallelRange::claim(int &first, int &last) {
+    // guided self scheduling, big chunks first and grain sized ones at the tail
+    int current = next.load(std::memory_order_relaxed);
+    while (current < end) {
+        int chunk = std::max(grain, (end - current) / (2 * participants));
+        int stop = std::min(current + chunk, end);
+        if (next.compare_exchange_weak(current, stop, std::memory_order_relaxed)) {
+            first = current;
+            last = stop;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::ParallelRange::complete(int count) {
+    if (remaining.fetch_sub(count) == count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.notify_all();
+    }
+}
+
+void ThreadPool::ParallelRange::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] {
+        return remaining.load() == 0;
+    });
 }
@@ -3,11 +3,14 @@
 #include "AppConfig.h"
 #include "NeuralNetwork/Matrix.h"
 #include "NeuralNetwork/NeuralNetwork.h"
-#include "SnakeApp.h"
-#include "SnakeModel.h"
+#include "Simulation/Fitness.h"
+#include "Simulation/HeadlessGame.h"
+#include "Simulation/LaneEvaluator.h"
 #include "Thread/ThreadPool.h"
 #include "Utility.h"
+#include <atomic>
 #include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
@@ -17,21 +20,98 @@
 #include <indicators/block_progress_bar.hpp>
 #include <indicators/cursor_control.hpp>
 #include <indicators/progress_bar.hpp>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <numeric>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 using namespace indicators;
 
+namespace {
+
+    // 0 based ranks by descending value, ties share their mean rank
+    std::pmr::vector<double> rankOf(const std::pmr::vector<long double> &values) {
+        const int n = values.size();
+        std::pmr::vector<int> order(n, 0, values.get_allocator().resource());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&values](int a, int b) { return values[a] > values[b]; });
+
+        std::pmr::vector<double> ranks(n, 0, values.get_allocator().resource());
+        for (int first = 0, last = 0; first < n; first = last) {
+            while (last < n && values[order[last]] == values[order[first]]) {
+                last++;
+            }
+            for (int k = first; k < last; k++) {
+                ranks[order[k]] = (first + last - 1) / 2.0;
+            }
+        }
+        return ranks;
+    }
+
+    // rank correlation of two orderings of the same population, 1 is the same order
+    double spearman(const std::pmr::vector<long double> &a, const std::pmr::vector<long double> &b) {
+        auto ra = rankOf(a);
+        auto rb = rankOf(b);
+        const int n = ra.size();
+        const double mean = (n - 1) / 2.0;
+
+        double cov = 0, va = 0, vb = 0;
+        for (int i = 0; i < n; i++) {
+            cov += (ra[i] - mean) * (rb[i] - mean);
+            va += (ra[i] - mean) * (ra[i] - mean);
+            vb += (rb[i] - mean) * (rb[i] - mean);
+        }
+        return va > 0 && vb > 0 ? cov / std::sqrt(va * vb) : 1.0;
+    }
+
+    // how many of the top k by a are also in the top k by b, ties broken by index like the sort before selection
+    int topOverlap(const std::pmr::vector<long double> &a, const std::pmr::vector<long double> &b, int k) {
+        auto top = [k](const std::pmr::vector<long double> &values) {
+            std::pmr::vector<int> order(values.size(), 0, values.get_allocator().resource());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&values](int x, int y) { return values[x] > values[y]; });
+            order.resize(std::min<size_t>(k, order.size()));
+            std::sort(order.begin(), order.end());
+            return order;
+        };
+        auto ta = top(a);
+        auto tb = top(b);
+
+        int overlap = 0;
+        for (int i = 0, j = 0; i < int(ta.size()) && j < int(tb.size());) {
+            if (ta[i] == tb[j]) {
+                overlap++, i++, j++;
+            } else if (ta[i] < tb[j]) {
+                i++;
+            } else {
+                j++;
+            }
+        }
+        return overlap;
+    }
+
+} // namespace
+
 TrainApp::TrainApp() {
 
     m_trainTaskDone = false;
+    m_settings = GameSettings::capture();
 
     m_maxGeneration = AppConfig::MaxGeneration();
     m_populationSize = AppConfig::PopulationSize();
     m_sampleSize = AppConfig::SampleSize();
+    m_targetPopulation = m_populationSize;
 
     m_generation = 1;
 
+    m_masterSeed = AppConfig::MasterSeed();
+    if (m_masterSeed != 0) {
+        utility::random::seed(m_masterSeed);
+    }
+
     m_samplesFitnessSum = 0;
 
     m_trainingDataPath = AppConfig::TrainingDataPath();
@@ -41,8 +121,7 @@ TrainApp::TrainApp() {
     m_genDirNameFormat = std::string("gen_{:07}");
     m_TrainResultFileNameFormat = std::string("nn_{:05}.json");
 
-    m_pool = new ThreadPool();
-
+    initThreadPool();
     initMutateTable();
     initPopulation();
     initSamples();
@@ -51,9 +130,7 @@ TrainApp::TrainApp() {
 TrainApp::~TrainApp() {
 
     LOG(INFO) << fmt::format("pool busy = {}\n", m_pool->isBusy());
-    if (m_pool->isBusy()) {
-        m_pool->done();
-    }
+    m_pool->done();
 
     LOG(INFO) << fmt::format("after pool->done, pool busy = {}\n", m_pool->isBusy());
 
@@ -88,8 +165,8 @@ int TrainApp::start() {
     // avoid save twice
     if (AppConfig::LatestSaveGeneration() != m_maxGeneration) {
         m_samples.clear();
-        this->selectPopulationTo(m_samples, m_sampleSize);
-        this->saveTrainingResults(m_samples, m_maxGeneration);
+        this->selectPopulationTo(m_samples, m_sampleGenomes, m_sampleSize);
+        this->saveTrainingResults(m_samples, m_sampleGenomes, m_maxGeneration);
 
         this->updateLatestSaveGenInfo(m_maxGeneration);
         this->updateLatestNNFile(m_maxGeneration);
@@ -114,6 +191,11 @@ void TrainApp::training() {
 
 void TrainApp::trainingImpl() {
 
+    if (AppConfig::SteadyState()) {
+        trainingSteadyStateImpl();
+        return;
+    }
+
     show_console_cursor(false);
 
     BlockProgressBar bar{
@@ -126,6 +208,10 @@ void TrainApp::trainingImpl() {
     bar.set_progress(m_generation);
 
     do {
+        // the generation barrier, the scratch of the last one is dropped. only this
+        // thread allocates from its arena, the pool workers never do
+        utility::memory::resetArena();
+
         bar.set_option(
             option::PostfixText{std::to_string(m_generation) + "/" + std::to_string(m_maxGeneration)});
 
@@ -134,22 +220,26 @@ void TrainApp::trainingImpl() {
         ///////////////////////////////////////////////////////////////////////
         this->evaluate();
         this->samplingEvaluateResult();
+        this->budgetGeneration();
 
         // next generation
 
         if (m_generation + 1 <= m_maxGeneration) {
+            auto breedStart = std::chrono::high_resolution_clock::now();
             this->selection();
             this->crossover();
             this->mutate();
+            std::chrono::duration<double, std::milli> breed = std::chrono::high_resolution_clock::now() - breedStart;
+            m_breedMs = breed.count();
         }
         ///////////////////////////////////////////////////////////////////////
 
         m_generationEndTime = std::chrono::high_resolution_clock::now();
         m_generationDuration = m_generationEndTime - m_generationStartTime;
 
-        std::string generationLog = fmt::format("GA: generation = {} Total - {}",
-                                                m_generation,
-                                                utility::time::formatToString(m_generationDuration));
+        auto generationLog = utility::memory::format("GA: generation = {} Total - {}",
+                                                     m_generation,
+                                                     utility::time::formatToString(m_generationDuration));
         LOG(INFO) << generationLog;
         bar.set_progress(m_generation);
 
@@ -159,9 +249,223 @@ void TrainApp::trainingImpl() {
     show_console_cursor(true);
 }
 
+void TrainApp::trainingSteadyStateImpl() {
+    // no generation barrier: a worker that finished a game puts the child into the
+    // ranked population at once, breeds the next one from it and plays that.
+    // the population stays sorted by fitness, a child better than the worst takes
+    // its place, parents are drawn from the best sampleSize like selection does.
+    // a generation is population size evaluations, for reports and checkpoints.
+
+    show_console_cursor(false);
+
+    BlockProgressBar bar{
+        option::BarWidth{50},
+        option::ForegroundColor{Color::green},
+        option::ShowElapsedTime{true},
+        option::ShowRemainingTime{true},
+        option::MaxProgress{m_maxGeneration}};
+
+    bar.set_progress(m_generation);
+
+    // a child is scored like the first generation: on its shared seeds with several
+    // games, whole games always. stages and the generation budget would score the
+    // first generation on cut games, they are off in this mode
+    if (AppConfig::EvaluationStages() > 1) {
+        LOG(WARNING) << "evaluationStages is ignored in steady state, every game is played to the end";
+    }
+    if (AppConfig::GenerationBudgetMs() > 0) {
+        LOG(WARNING) << "generationBudgetMs is ignored in steady state";
+    }
+
+    // the first generation as usual, it ranks the population the children compete with
+    utility::memory::resetArena();
+    this->evaluate();
+    this->samplingEvaluateResult();
+
+    const int laneNum = m_pool->size();
+    const int genomeSize = m_genomes.genomeSize();
+    const int perGeneration = m_population.size();
+    const int parentNum = std::min<int>(m_sampleSize, m_population.size());
+    const int firstGeneration = m_generation;
+    const long long target = (long long)std::max(0, m_maxGeneration - firstGeneration) * perGeneration;
+    const unsigned int evaluationSeed = AppConfig::EvaluationSeed();
+    const int games = std::max(1, AppConfig::EvaluationGames());
+    const sim::FitnessAggregate aggregate = sim::fitnessAggregateOf(AppConfig::EvaluationAggregate());
+    const double quantile = AppConfig::EvaluationQuantile();
+    const std::vector<unsigned int> seeds = m_evaluationSeeds; /* of the first generation, every child plays them */
+
+    std::mutex populationMutex; /* m_population, m_genomes, the counters below */
+    std::mutex checkpointMutex; /* one generation report at a time */
+    long long dispatched = 0;
+    long long completed = 0;
+    long long replaced = 0;
+    int lastReported = firstGeneration; /* under checkpointMutex */
+    long double parentFitnessSum = 0;
+    for (int i = 0; i < parentNum; i++) {
+        parentFitnessSum += m_population[i].fitness;
+    }
+
+    std::atomic<long long> busyNs{0};
+    auto generationStart = std::chrono::high_resolution_clock::now();
+    long long busyAtGenerationStart = 0;
+
+    auto pickParent = [&]() {
+        // RouletteWheelSelection over the best parentNum
+        long double slice = utility::random::generateRandomDouble(0, 1) * parentFitnessSum;
+        long double total = 0;
+        for (int i = 0; i < parentNum; i++) {
+            total += m_population[i].fitness;
+            if (total > slice) {
+                return i;
+            }
+        }
+        return parentNum - 1;
+    };
+
+    // under checkpointMutex, by the worker whose child completed the generation.
+    // two workers can complete generations back to back and take the mutex in
+    // either order, a generation older than the last one reported is dropped
+    auto endGeneration = [&](int generation, long long replacedSoFar) {
+        if (generation <= lastReported) {
+            return;
+        }
+        lastReported = generation;
+
+        auto now = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::milli> wall = now - generationStart;
+        long long busy = busyNs.load() - busyAtGenerationStart;
+        generationStart = now;
+        busyAtGenerationStart += busy;
+
+        bool save = 0 == generation % AppConfig::SaveFrequency();
+        {
+            std::unique_lock<std::mutex> lock(populationMutex);
+            m_generation = generation;
+            if (0 == generation % AppConfig::ReportFrequency()) {
+                reportGenerationInfo(generation);
+            }
+            if (save) {
+                selectPopulationTo(m_samples, m_sampleGenomes, m_sampleSize);
+            }
+        }
+        if (save) {
+            saveSamples();
+        }
+
+        LOG(INFO) << utility::memory::format("GA: generation = {} steady state evaluations = {}, replaced = {}, worker busy = {:.1f}%, Total - {}",
+                                             generation, (long long)(generation - firstGeneration) * perGeneration, replacedSoFar,
+                                             wall.count() > 0 ? 100.0 * busy / 1e6 / (laneNum * wall.count()) : 0.0,
+                                             utility::time::formatToString(wall));
+        bar.set_option(option::PostfixText{std::to_string(generation) + "/" + std::to_string(m_maxGeneration)});
+        bar.set_progress(generation);
+
+        // the report and save were this thread's only use of its arena, none of it is alive
+        utility::memory::resetArena();
+    };
+
+    m_pool->parallelFor(0, laneNum, 1, [&](int lane) {
+        ga::EvalContext &context = *m_contexts[lane];
+        sim::HeadlessGame &game = context.game();
+        std::vector<double> parent1(genomeSize), parent2(genomeSize), child(genomeSize);
+        std::vector<long double> values(games);
+
+        while (true) {
+            uint32_t parentIds[2];
+            long long childNumber = 0;
+            {
+                std::unique_lock<std::mutex> lock(populationMutex);
+                if (dispatched >= target) {
+                    break;
+                }
+                childNumber = dispatched++;
+
+                // with a master seed the draws of a child follow from its number,
+                // with one worker the whole run repeats
+                reseed(RandomStream::steadyCrossover, firstGeneration, childNumber);
+
+                int parentIndex1 = pickParent();
+                int parentIndex2 = pickParent();
+                while (parentNum > 1 && parentIndex1 == parentIndex2) {
+                    parentIndex2 = pickParent();
+                }
+                std::copy_n(m_genomes.at(m_population[parentIndex1].genome), genomeSize, parent1.data());
+                std::copy_n(m_genomes.at(m_population[parentIndex2].genome), genomeSize, parent2.data());
+                parentIds[0] = m_population[parentIndex1].id;
+                parentIds[1] = m_population[parentIndex2].id;
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+
+            // crossoverImpl and mutateImpl for one child
+            for (int w = 0; w < genomeSize; w++) {
+                double d = utility::random::generateRandomDouble(0, 1);
+                child[w] = d > 0.5 ? parent1[w] : parent2[w];
+            }
+            reseed(RandomStream::steadyMutate, firstGeneration, childNumber);
+            ga::mutate(child.data(), genomeSize, m_mutateValueTable);
+
+            // runEvaluationJobs for one individual
+            context.loadGenome(child.data());
+            reseed(RandomStream::steadyGameSeeds, firstGeneration, childNumber);
+            const unsigned int seed = games > 1 ? seeds[0]
+                                                : (evaluationSeed != 0 ? evaluationSeed : utility::random::generateRandomNumber(1, std::numeric_limits<int>::max()));
+            long long score = 0, totalSteps = 0, eatSteps = 0;
+            for (int k = 0; k < games; k++) {
+                game.reset(games > 1 ? seeds[k] : seed);
+                sim::playGame(game, context.brain(), 0);
+                const sim::GameState &s = game.state();
+                values[k] = sim::fitness(s.score, s.totalSteps);
+                score += s.score;
+                totalSteps += s.totalSteps;
+                eatSteps += s.eatSteps;
+            }
+            const long double fitness = games > 1 ? sim::aggregateFitness(values.data(), games, aggregate, quantile) : values[0];
+
+            busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+            int generation = 0;
+            long long replacedSoFar = 0;
+            {
+                std::unique_lock<std::mutex> lock(populationMutex);
+                if (fitness > m_population.back().fitness) {
+                    // the worst leaves, the child moves up to its rank
+                    ga::Individual &worst = m_population.back();
+                    std::copy_n(child.data(), genomeSize, m_genomes.at(worst.genome));
+                    worst = ga::Individual{m_nextId++, {parentIds[0], parentIds[1]}, worst.genome,
+                                           int(score / games), int(totalSteps / games), int(eatSteps / games), int(totalSteps / games), seed, fitness};
+                    for (int i = m_population.size() - 1; i > 0 && m_population[i - 1].fitness < m_population[i].fitness; i--) {
+                        std::swap(m_population[i - 1], m_population[i]);
+                    }
+
+                    parentFitnessSum = 0;
+                    for (int i = 0; i < parentNum; i++) {
+                        parentFitnessSum += m_population[i].fitness;
+                    }
+                    replaced++;
+                }
+
+                completed++;
+                if (0 == completed % perGeneration) {
+                    generation = firstGeneration + completed / perGeneration;
+                    replacedSoFar = replaced;
+                }
+            }
+
+            if (generation > 0) {
+                std::unique_lock<std::mutex> checkpoint(checkpointMutex);
+                endGeneration(generation, replacedSoFar);
+            }
+        }
+    });
+
+    m_generation = m_maxGeneration;
+    bar.mark_as_completed();
+    show_console_cursor(true);
+}
+
 void TrainApp::evaluate() {
-    std::string result;
-    std::string label = fmt::format("GA: generation = {} evaluate", m_generation);
+    std::pmr::string result(utility::memory::generationResource());
+    auto label = utility::memory::format("GA: generation = {} evaluate", m_generation);
 
     utility::time::measure(label, result, [&]() {
         this->evaluateImpl();
@@ -171,23 +475,512 @@ void TrainApp::evaluate() {
 }
 
 void TrainApp::evaluateImpl() {
-    // run until all snakes die
-    for (auto &snakeApp : m_population) {
-        m_pool->queueJob([&snakeApp]() {
-            snakeApp->start();
+    // run until all snakes die, the fitness comes with the results
+    runEvaluationJobs();
+
+    // sort the rank
+    std::sort(m_population.begin(), m_population.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.fitness > rhs.fitness; });
+}
+
+void TrainApp::runEvaluationJobs() {
+    // longest expected first (LPT), the generation ends with the slowest snake,
+    // so the long lived ones must not be picked up last.
+    // an unfinished slice goes back to the queue with its remaining estimate,
+    // its game parked until a thread picks it up again.
+    // staged (successive halving): every game plays a short budget, only the best
+    // fraction of the unfinished ones plays on with a longer one, the others keep
+    // the fitness they reached so far. the last stage plays to the end.
+    // with several games per individual (common random numbers) every individual
+    // plays the same seeds of this generation, one job plays all of its games,
+    // side by side on the lanes. the games are whole, no slices and no stages.
+    // a step cap (the generation budget) ends a game early with the score it has,
+    // capped games are played one by one.
+    struct EvaluationJob {
+        int index;
+        int expectedSteps;
+        int doneSteps;
+        unsigned int seed;
+        int parked; /* slot in m_parkedGames, -1 for none */
+        int budget; /* steps this stage lets the game reach, 0 for no limit */
+    };
+
+    auto lessUrgent = [](const EvaluationJob &a, const EvaluationJob &b) {
+        int remainA = a.expectedSteps - a.doneSteps;
+        int remainB = b.expectedSteps - b.doneSteps;
+        return remainA != remainB ? remainA < remainB : a.index > b.index;
+    };
+
+    const bool lpt = AppConfig::LPTScheduling();
+    const int sliceSteps = AppConfig::EvaluationGames() > 1 ? 0 : AppConfig::EvaluationSliceSteps();
+    const int inferenceLanes = AppConfig::InferenceLanes();
+    const bool loopDetection = AppConfig::LoopDetection();
+    const int laneNum = m_pool->size();
+    const int populationSize = m_population.size();
+    const int games = std::max(1, AppConfig::EvaluationGames());
+    const bool multi = games > 1;
+    const sim::FitnessAggregate aggregate = sim::fitnessAggregateOf(AppConfig::EvaluationAggregate());
+    const double quantile = AppConfig::EvaluationQuantile();
+    const int stages = AppConfig::EvaluationStages();
+    const bool staged = stages > 1 && !multi && !AppConfig::SteadyState();
+    const int stepCap = m_stepCap;
+    const double stageKeep = std::clamp(AppConfig::EvaluationStageKeep(), 0.0, 1.0);
+    const bool audit = staged && AppConfig::EvaluationStageAuditFrequency() > 0 &&
+                       0 == m_generation % AppConfig::EvaluationStageAuditFrequency();
+    int budget = staged ? std::max(1, AppConfig::EvaluationStageSteps()) : 0;
+
+    // a reusable context per thread, with inferenceLanes it plays whole games in lockstep, no slicing
+    if (int(m_contexts.size()) != laneNum) {
+        m_contexts.clear();
+        for (int i = 0; i < laneNum; i++) {
+            m_contexts.push_back(std::make_unique<ga::EvalContext>(*m_settings, inferenceLanes, loopDetection));
+        }
+    }
+
+    // scratch of this generation, in the calling thread's arena.
+    // the queue never outgrows the population, the workers do not reallocate it
+    std::pmr::memory_resource *scratch = utility::memory::generationResource();
+    std::pmr::vector<EvaluationJob> queue(scratch);
+    queue.reserve(populationSize);
+
+    // the seeds of this generation's games. a fixed seed gives the same seeds every
+    // generation, the first is the seed itself
+    const unsigned int evaluationSeed = AppConfig::EvaluationSeed();
+    reseed(RandomStream::gameSeeds, 0);
+    std::pmr::vector<unsigned int> seeds(multi ? games : 0, 0, scratch);
+    uint64_t seedSet = evaluationSeed;
+    if (multi) {
+        std::minstd_rand seedRng(evaluationSeed);
+        std::uniform_int_distribution<unsigned int> dist(1, std::numeric_limits<int>::max());
+        seedSet = 0;
+        for (int k = 0; k < games; k++) {
+            seeds[k] = evaluationSeed == 0 ? utility::random::generateRandomNumber(1, std::numeric_limits<int>::max())
+                                           : (k == 0 ? evaluationSeed : dist(seedRng));
+            seedSet = ga::FitnessCache::key(seedSet, seeds[k]);
+        }
+        m_evaluationSeeds.assign(seeds.begin(), seeds.end());
+    }
+    // and the rules they run under, the generation budget changes them
+    seedSet = ga::FitnessCache::key(seedSet, (uint64_t(m_settings->wanderThreshold) << 32) | uint32_t(stepCap));
+
+    // the results of every game and their fitness, individual major
+    std::pmr::vector<sim::EpisodeResult> gameResults(multi ? populationSize * games : 0, sim::EpisodeResult{}, scratch);
+    std::pmr::vector<long double> gameFitness(multi ? populationSize * games : 0, 0, scratch);
+
+    // with a fixed seed a genome plays the same games every time: one evaluated
+    // before comes from the cache, a copy of one in this generation waits for it
+    const bool cached = evaluationSeed != 0 && AppConfig::FitnessCache();
+    std::pmr::vector<uint64_t> cacheKeys(cached ? populationSize : 0, 0, scratch);
+    std::pmr::vector<int> sameAs(populationSize, -1, scratch); /* evaluated as that individual of this generation */
+    std::pmr::vector<uint8_t> provisional(populationSize, 0, scratch);
+    int cacheHits = 0, duplicates = 0;
+
+    if (cached) {
+        m_fitnessCache.nextGeneration();
+        std::pmr::unordered_map<uint64_t, int> firstOf(scratch);
+        for (int i = 0; i < populationSize; i++) {
+            ga::Individual &individual = m_population[i];
+            cacheKeys[i] = ga::FitnessCache::key(ga::genomeHash(m_genomes.at(individual.genome), m_genomes.genomeSize()), seedSet);
+
+            ga::FitnessCache::Result result;
+            if (m_fitnessCache.lookup(cacheKeys[i], result)) {
+                individual.score = result.score;
+                individual.totalSteps = result.totalSteps;
+                individual.eatSteps = result.eatSteps;
+                individual.fitness = result.fitness;
+                sameAs[i] = i;
+                cacheHits++;
+                continue;
+            }
+
+            auto first = firstOf.emplace(cacheKeys[i], i);
+            if (!first.second) {
+                sameAs[i] = first.first->second;
+                duplicates++;
+            }
+        }
+    }
+
+    for (int i = 0; i < populationSize; i++) {
+        if (sameAs[i] >= 0) {
+            m_population[i].seed = multi ? seeds[0] : evaluationSeed;
+            continue;
+        }
+        int expected = lpt ? m_population[i].expectedSteps * games : 0;
+        unsigned int seed = multi ? seeds[0] : (evaluationSeed != 0 ? evaluationSeed : utility::random::generateRandomNumber(1, std::numeric_limits<int>::max()));
+        m_population[i].seed = seed;
+        queue.push_back(EvaluationJob{i, expected, 0, seed, -1, budget});
+    }
+    std::pmr::vector<EvaluationJob> held(scratch); /* out of budget for this stage, parked */
+    held.reserve(populationSize);
+    std::make_heap(queue.begin(), queue.end(), lessUrgent);
+
+    std::mutex queueMutex;
+    std::pmr::vector<double> laneBusy(laneNum, 0, scratch);
+    std::pmr::vector<double> laneFirstStart(laneNum, -1, scratch);
+    std::pmr::vector<double> laneIdleFrom(laneNum, 0, scratch);
+    std::pmr::vector<long long> laneSteps(laneNum, 0, scratch);
+    std::pmr::vector<int> laneLoops(laneNum, 0, scratch);
+    std::pmr::vector<int> laneCapped(laneNum, 0, scratch);
+    const unsigned long long allocationsBefore = utility::alloc::totalCount();
+    auto evaluateStart = std::chrono::high_resolution_clock::now();
+    auto sinceStart = [&evaluateStart]() {
+        std::chrono::duration<double, std::milli> d = std::chrono::high_resolution_clock::now() - evaluateStart;
+        return d.count();
+    };
+
+    auto popJob = [&](EvaluationJob &job) {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        if (queue.empty()) {
+            return false;
+        }
+        std::pop_heap(queue.begin(), queue.end(), lessUrgent);
+        job = queue.back();
+        queue.pop_back();
+        return true;
+    };
+
+    auto setResult = [&](int lane, int index, int score, int totalSteps, int eatSteps, sim::StepResult end) {
+        ga::Individual &individual = m_population[index];
+        individual.score = score;
+        individual.totalSteps = totalSteps;
+        individual.eatSteps = eatSteps;
+        laneSteps[lane] += totalSteps;
+        laneLoops[lane] += end == sim::StepResult::looped;
+    };
+
+    // game k of an individual, with several games per individual
+    auto setGameResult = [&](int lane, int index, int k, const sim::EpisodeResult &result) {
+        gameResults[index * games + k] = result;
+        laneSteps[lane] += result.totalSteps;
+        laneLoops[lane] += result.end == sim::StepResult::looped;
+    };
+
+    // under queueMutex
+    auto park = [&](EvaluationJob &job, const sim::HeadlessGame &game) {
+        if (m_freeParked.empty()) {
+            job.parked = m_parkedGames.size();
+            m_parkedGames.push_back(game);
+        } else {
+            job.parked = m_freeParked.back();
+            m_freeParked.pop_back();
+            m_parkedGames[job.parked] = game;
+        }
+    };
+
+    // a lane can not stop a game and go on with it later, staged games are played one by one
+    auto worker = [&](int lane) {
+        ga::EvalContext &context = *m_contexts[lane];
+        if (laneFirstStart[lane] < 0) {
+            laneFirstStart[lane] = sinceStart();
+        }
+
+        if (context.lanes() && !staged && stepCap == 0) {
+            double runStart = sinceStart();
+            EvaluationJob job;
+            int nextGame = games; /* of job, its games go to the lanes one by one */
+            context.lanes()->run(
+                [&](sim::LaneEvaluator::Job &next) {
+                    if (nextGame == games) {
+                        if (!popJob(job)) {
+                            return false;
+                        }
+                        nextGame = 0;
+                    }
+                    const double *genome = m_genomes.at(m_population[job.index].genome);
+                    if (multi) {
+                        next = sim::LaneEvaluator::Job{job.index * games + nextGame, genome, seeds[nextGame]};
+                    } else {
+                        next = sim::LaneEvaluator::Job{job.index, genome, job.seed};
+                    }
+                    nextGame++;
+                    return true;
+                },
+                [&](int index, const sim::EpisodeResult &result) {
+                    if (multi) {
+                        setGameResult(lane, index / games, index % games, result);
+                    } else {
+                        setResult(lane, index, result.score, result.totalSteps, result.eatSteps, result.end);
+                    }
+                });
+            laneBusy[lane] += sinceStart() - runStart;
+            laneIdleFrom[lane] = std::max(laneIdleFrom[lane], sinceStart());
+            return;
+        }
+
+        sim::HeadlessGame &game = context.game();
+        EvaluationJob job;
+        while (popJob(job)) {
+            double sliceStart = sinceStart();
+            context.loadGenome(m_genomes.at(m_population[job.index].genome));
+            if (multi) {
+                for (int k = 0; k < games; k++) {
+                    game.reset(seeds[k]);
+                    if (!sim::playGame(game, context.brain(), stepCap)) {
+                        provisional[job.index] = 1;
+                        laneCapped[lane]++;
+                    }
+                    const sim::GameState &s = game.state();
+                    setGameResult(lane, job.index, k, sim::EpisodeResult{seeds[k], s.score, s.totalSteps, s.eatSteps, s.last});
+                }
+                laneBusy[lane] += sinceStart() - sliceStart;
+                continue;
+            }
+            if (0 == job.doneSteps) {
+                game.reset(job.seed);
+            } else {
+                std::unique_lock<std::mutex> lock(queueMutex);
+                game = m_parkedGames[job.parked];
+                m_freeParked.push_back(job.parked);
+                job.parked = -1;
+            }
+
+            int steps = job.budget > 0 ? job.budget - job.doneSteps : 0;
+            if (sliceSteps > 0 && (steps <= 0 || steps > sliceSteps)) {
+                steps = sliceSteps;
+            }
+            if (stepCap > 0 && (steps <= 0 || steps > stepCap - job.doneSteps)) {
+                steps = stepCap - job.doneSteps;
+            }
+
+            bool end = sim::playGame(game, context.brain(), steps);
+            bool capped = !end && stepCap > 0 && job.doneSteps + steps >= stepCap;
+            if (end || capped) {
+                const sim::GameState &result = game.state();
+                setResult(lane, job.index, result.score, result.totalSteps, result.eatSteps, result.last);
+            }
+            if (capped) {
+                provisional[job.index] = 1;
+                laneCapped[lane]++;
+            }
+            laneBusy[lane] += sinceStart() - sliceStart;
+
+            if (!end && !capped) {
+                job.doneSteps += steps;
+                if (job.doneSteps >= job.expectedSteps) {
+                    // outlived the prediction, assume it lives as long again
+                    job.expectedSteps = 2 * job.doneSteps;
+                }
+
+                std::unique_lock<std::mutex> lock(queueMutex);
+                park(job, game);
+                if (job.budget > 0 && job.doneSteps >= job.budget) {
+                    held.push_back(job);
+                } else {
+                    queue.push_back(job);
+                    std::push_heap(queue.begin(), queue.end(), lessUrgent);
+                }
+            }
+        }
+
+        laneIdleFrom[lane] = std::max(laneIdleFrom[lane], sinceStart());
+    };
+
+    // culled in an audited generation, played to the end afterwards
+    std::pmr::vector<EvaluationJob> culled(scratch);
+    int culledNum = 0;
+
+    for (int stage = 1;; stage++) {
+        m_pool->parallelFor(0, laneNum, 1, worker);
+        if (held.empty()) {
+            break;
+        }
+
+        // the best by fitness so far play on, every step between stages culls,
+        // the one into the last stage too. the last stage has no budget
+        auto fitnessSoFar = [this](const EvaluationJob &job) {
+            const sim::GameState &s = m_parkedGames[job.parked].state();
+            return sim::fitness(s.score, s.totalSteps);
+        };
+        std::sort(held.begin(), held.end(), [&](const EvaluationJob &a, const EvaluationJob &b) {
+            long double fa = fitnessSoFar(a), fb = fitnessSoFar(b);
+            return fa != fb ? fa > fb : a.index < b.index;
         });
+
+        const bool last = stage + 1 >= stages;
+        const int keep = int(std::ceil(held.size() * stageKeep));
+        budget = last ? 0 : int(std::min<long long>(std::numeric_limits<int>::max(), std::llround(budget / std::max(stageKeep, 1e-3))));
+
+        for (int k = 0; k < int(held.size()); k++) {
+            EvaluationJob job = held[k];
+            if (k < keep) {
+                job.budget = budget;
+                queue.push_back(job);
+                continue;
+            }
+
+            const sim::GameState &s = m_parkedGames[job.parked].state();
+            setResult(0, job.index, s.score, s.totalSteps, s.eatSteps, s.last);
+            provisional[job.index] = 1;
+            culledNum++;
+            if (audit) {
+                culled.push_back(job);
+            } else {
+                m_freeParked.push_back(job.parked);
+            }
+        }
+        held.clear();
+        std::make_heap(queue.begin(), queue.end(), lessUrgent);
     }
 
-    waitDieOut();
+    // the fitness of every individual played. of several games the aggregate,
+    // the score and steps kept for reports and LPT are the games' means
+    std::pmr::vector<double> spread(multi ? populationSize : 0, 0, scratch);
+    m_pool->parallelFor(0, populationSize, c_cheapJobGrain, [&](int i) {
+        ga::Individual &individual = m_population[i];
+        if (sameAs[i] >= 0) {
+            return;
+        }
+        if (!multi) {
+            individual.fitness = sim::fitness(individual.score, individual.totalSteps);
+            return;
+        }
+
+        long double *values = &gameFitness[i * games];
+        long long score = 0, totalSteps = 0, eatSteps = 0;
+        for (int k = 0; k < games; k++) {
+            const sim::EpisodeResult &result = gameResults[i * games + k];
+            values[k] = sim::fitness(result.score, result.totalSteps);
+            score += result.score;
+            totalSteps += result.totalSteps;
+            eatSteps += result.eatSteps;
+        }
+        individual.score = int(score / games);
+        individual.totalSteps = int(totalSteps / games);
+        individual.eatSteps = int(eatSteps / games);
+
+        long double mean = sim::aggregateFitness(values, games, sim::FitnessAggregate::mean, 0);
+        long double variance = 0;
+        for (int k = 0; k < games; k++) {
+            variance += (values[k] - mean) * (values[k] - mean);
+        }
+        spread[i] = mean > 0 ? double(std::sqrt(variance / (games - 1)) / mean) : 0.0;
+        individual.fitness = sim::aggregateFitness(values, games, aggregate, quantile);
+    });
 
-    // caculate the fitness
-    for (auto &snakeApp : m_population) {
-        snakeApp->getSnakeModel()->fitness();
+    if (multi) {
+        const int played = std::count(sameAs.begin(), sameAs.end(), -1);
+        auto aggregateName = aggregate == sim::FitnessAggregate::quantile ? utility::memory::format("quantile {:.2f}", quantile)
+                                                                          : utility::memory::format("{}", sim::nameOf(aggregate));
+        LOG(INFO) << utility::memory::format("GA: generation = {} evaluate games = {} per individual, aggregate = {}, played = {} of {}, mean relative spread of the games = {:.1f}%",
+                                             m_generation, games, aggregateName, played, populationSize,
+                                             played > 0 ? 100.0 * std::accumulate(spread.begin(), spread.end(), 0.0) / played : 0.0);
     }
 
-    // sort the rank
-    std::sort(m_population.begin(), m_population.end(),
-              [](const auto &lhs, const auto &rhs) { return lhs->getSnakeModel()->getRank() > rhs->getSnakeModel()->getRank(); });
+    if (cached) {
+        for (int i = 0; i < populationSize; i++) {
+            ga::Individual &individual = m_population[i];
+            if (sameAs[i] < 0 && !provisional[i]) {
+                m_fitnessCache.insert(cacheKeys[i], ga::FitnessCache::Result{individual.score, individual.totalSteps, individual.eatSteps, individual.fitness});
+            } else if (sameAs[i] != i && sameAs[i] >= 0) {
+                const ga::Individual &source = m_population[sameAs[i]];
+                individual.score = source.score;
+                individual.totalSteps = source.totalSteps;
+                individual.eatSteps = source.eatSteps;
+                individual.fitness = source.fitness;
+            }
+        }
+
+        LOG(INFO) << utility::memory::format("GA: generation = {} evaluate fitness cache hits = {}, duplicates = {}, played = {} of {}, cache entries = {}",
+                                             m_generation, cacheHits, duplicates, populationSize - cacheHits - duplicates, populationSize,
+                                             m_fitnessCache.size());
+    }
+
+    // idle core time: the gaps of every lane between its first dispatch and the end
+    // of its last job, a lane not yet dispatched was waiting for a cpu, not idle
+    double wall = sinceStart();
+    double laneTime = 0, firstIdle = wall;
+    m_evaluateIdleCoreMs = 0;
+    for (int lane = 0; lane < laneNum; lane++) {
+        if (laneFirstStart[lane] >= 0) {
+            laneTime += laneIdleFrom[lane] - laneFirstStart[lane];
+            m_evaluateIdleCoreMs += std::max(0.0, laneIdleFrom[lane] - laneFirstStart[lane] - laneBusy[lane]);
+            firstIdle = std::min(firstIdle, laneIdleFrom[lane]);
+        }
+    }
+    m_evaluateTailMs = wall - firstIdle;
+
+    // for the generation budget
+    m_evaluateSteps = std::accumulate(laneSteps.begin(), laneSteps.end(), 0LL);
+    m_evaluateCapped = std::accumulate(laneCapped.begin(), laneCapped.end(), 0);
+    m_evaluateLongestGame = 0;
+    for (const auto &individual : m_population) {
+        m_evaluateLongestGame = std::max(m_evaluateLongestGame, individual.totalSteps);
+    }
+    if (stepCap > 0) {
+        LOG(INFO) << utility::memory::format("GA: generation = {} evaluate step cap = {}, capped games = {}",
+                                             m_generation, stepCap, m_evaluateCapped);
+    }
+
+    LOG(INFO) << utility::memory::format("GA: generation = {} evaluate schedule = {}, slice = {}, inference lanes = {}, lanes = {}, idle cores = {:.3f} core-ms ({:.2f}%), tail = {:.3f} ms",
+                                         m_generation,
+                                         lpt ? "LPT" : "FIFO",
+                                         sliceSteps,
+                                         inferenceLanes,
+                                         laneNum,
+                                         m_evaluateIdleCoreMs,
+                                         laneTime > 0 ? 100.0 * m_evaluateIdleCoreMs / laneTime : 0.0,
+                                         m_evaluateTailMs);
+
+    if (loopDetection) {
+        int loops = std::accumulate(laneLoops.begin(), laneLoops.end(), 0);
+        LOG(INFO) << utility::memory::format("GA: generation = {} evaluate loop kills = {} of {} games ({:.1f}%)",
+                                             m_generation, loops, populationSize,
+                                             populationSize > 0 ? 100.0 * loops / populationSize : 0.0);
+    }
+
+    if (utility::alloc::enabled()) {
+        unsigned long long allocations = utility::alloc::totalCount() - allocationsBefore;
+        long long steps = std::accumulate(laneSteps.begin(), laneSteps.end(), 0LL);
+        LOG(INFO) << utility::memory::format("GA: generation = {} evaluate allocations = {}, steps = {}, allocations per step = {:.4f}",
+                                             m_generation, allocations, steps, steps > 0 ? double(allocations) / steps : 0.0);
+    }
+
+    if (!staged) {
+        return;
+    }
+
+    const long long played = std::accumulate(laneSteps.begin(), laneSteps.end(), 0LL);
+    LOG(INFO) << utility::memory::format("GA: generation = {} evaluate stages = {}, first budget = {}, keep = {:.2f}, culled = {} of {}, steps = {}",
+                                         m_generation, stages, AppConfig::EvaluationStageSteps(), stageKeep, culledNum, populationSize, played);
+
+    if (!audit) {
+        return;
+    }
+
+    // the culled played to the end, what the stages saved and how they ranked against a full evaluation
+    std::pmr::vector<long double> stagedFitness(populationSize, 0, scratch);
+    for (int i = 0; i < populationSize; i++) {
+        stagedFitness[i] = sim::fitness(m_population[i].score, m_population[i].totalSteps);
+    }
+    std::pmr::vector<long double> fullFitness(stagedFitness, scratch);
+    std::pmr::vector<long long> extraSteps(culled.size(), 0, scratch);
+
+    std::atomic<int> nextCulled{0};
+    m_pool->parallelFor(0, laneNum, 1, [&](int lane) {
+        ga::EvalContext &context = *m_contexts[lane];
+        for (int k; (k = nextCulled++) < int(culled.size());) {
+            const EvaluationJob &job = culled[k];
+            sim::HeadlessGame &game = m_parkedGames[job.parked];
+            const int stagedSteps = game.state().totalSteps;
+
+            context.loadGenome(m_genomes.at(m_population[job.index].genome));
+            sim::playGame(game, context.brain(), 0);
+
+            fullFitness[job.index] = sim::fitness(game.state().score, game.state().totalSteps);
+            extraSteps[k] = game.state().totalSteps - stagedSteps;
+        }
+    });
+    for (const auto &job : culled) {
+        m_freeParked.push_back(job.parked);
+    }
+
+    const long long full = played + std::accumulate(extraSteps.begin(), extraSteps.end(), 0LL);
+    const int topK = std::min(m_sampleSize, populationSize);
+    LOG(INFO) << utility::memory::format("GA: generation = {} evaluate stage audit: full steps = {}, compute saved = {:.1f}%, rank agreement = {:.3f}, top {} agreement = {:.1f}%",
+                                         m_generation, full, full > 0 ? 100.0 * (full - played) / full : 0.0,
+                                         spearman(stagedFitness, fullFitness),
+                                         topK, topK > 0 ? 100.0 * topOverlap(stagedFitness, fullFitness, topK) / topK : 100.0);
 }
 
 void TrainApp::samplingEvaluateResult() {
@@ -202,9 +995,89 @@ void TrainApp::samplingEvaluateResult() {
     }
 }
 
+void TrainApp::budgetGeneration() {
+    // keep a generation to the wall clock budget. the one just played predicts the
+    // next: what it took against the budget is how much more or less to play.
+    // over the budget the population shrinks first, then the games are capped, then
+    // the wander threshold comes down. the slack gives them back in reverse order.
+    const int budgetMs = AppConfig::GenerationBudgetMs();
+    if (budgetMs <= 0 || m_evaluateSteps <= 0) {
+        return;
+    }
+
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::high_resolution_clock::now() - m_generationStartTime;
+    const double spentMs = std::max(elapsed.count() + m_breedMs, 1e-3);
+    const double ratio = std::clamp(budgetMs / spentMs, 0.5, 2.0); /* damped, no more than twice or half at once */
+
+    const int populationMin = std::max(2, AppConfig::BudgetPopulationMin() > 0 ? AppConfig::BudgetPopulationMin() : m_sampleSize);
+    const int populationMax = std::max(populationMin, AppConfig::BudgetPopulationMax() > 0 ? AppConfig::BudgetPopulationMax() : AppConfig::PopulationSize());
+    const int capMin = std::max(1, AppConfig::BudgetStepCapMin());
+    const int capMax = AppConfig::BudgetStepCapMax();
+    const int wanderMax = GameSettings::capture()->wanderThreshold;
+    const int wanderMin = AppConfig::BudgetWanderMin() > 0 ? std::min(AppConfig::BudgetWanderMin(), wanderMax) : wanderMax;
+
+    int population = m_targetPopulation;
+    int cap = m_stepCap;
+    int wander = m_settings->wanderThreshold;
+
+    if (ratio < 0.9) {
+        population = std::clamp(int(population * ratio), populationMin, populationMax);
+        double left = ratio * m_targetPopulation / population; /* what the population could not take */
+
+        if (left < 0.9) {
+            // assumes the steps go down with the cap, the long games are the ones it cuts.
+            // a cap above the longest game would not cut anything
+            const int from = cap > 0 ? cap : m_evaluateLongestGame;
+            const int next = std::max(capMin, int(from * left));
+            if (next < from) {
+                cap = next;
+                left *= double(from) / next;
+            }
+        }
+        if (left < 0.9) {
+            wander = std::clamp(int(wander * left), wanderMin, wanderMax);
+        }
+    } else if (ratio > 1.1) {
+        // one at a time, the way back is not hurried
+        if (wander < wanderMax) {
+            wander = std::clamp(int(wander * ratio), wanderMin, wanderMax);
+        } else if (cap > 0) {
+            // a cap no game reached does not hold anything back, one at its maximum
+            // comes off once the generation is well under the budget
+            const bool reached = m_evaluateCapped > 0;
+            if (!reached || (capMax > 0 && cap >= capMax && ratio >= c_budgetLiftRatio)) {
+                LOG(INFO) << utility::memory::format("GA: generation = {} budget step cap {} lifted, {}, spent {:.1f} of {} ms",
+                                                     m_generation, cap, reached ? "at its maximum" : "no game reached it", spentMs, budgetMs);
+                cap = 0;
+            } else {
+                cap = int(cap * ratio);
+                if (capMax > 0) {
+                    cap = std::min(cap, capMax);
+                }
+            }
+        } else {
+            population = std::clamp(int(population * ratio), populationMin, populationMax);
+        }
+    }
+
+    LOG(INFO) << utility::memory::format("GA: generation = {} budget = {} ms, spent {:.1f} ms, {:.0f} steps/s, longest game = {}, capped = {}: population {} -> {}, step cap {} -> {}, wander threshold {} -> {}",
+                                         m_generation, budgetMs, spentMs, m_evaluateSteps * 1000.0 / spentMs, m_evaluateLongestGame, m_evaluateCapped,
+                                         m_targetPopulation, population, m_stepCap, cap, m_settings->wanderThreshold, wander);
+
+    m_targetPopulation = population;
+    m_stepCap = cap;
+    if (wander != m_settings->wanderThreshold) {
+        // the games of the next evaluation are built for it
+        auto settings = std::make_shared<GameSettings>(*m_settings);
+        settings->wanderThreshold = wander;
+        m_settings = settings;
+        m_contexts.clear();
+    }
+}
+
 void TrainApp::selection() {
-    std::string result;
-    std::string label = fmt::format("GA: generation = {} selection", m_generation);
+    std::pmr::string result(utility::memory::generationResource());
+    auto label = utility::memory::format("GA: generation = {} selection", m_generation);
 
     utility::time::measure(label, result, [&]() {
         this->selectionImpl();
@@ -217,16 +1090,17 @@ void TrainApp::selectionImpl() {
     m_samplesFitnessSum = 0;
     m_samples.clear();
 
-    selectPopulationTo(m_samples, m_sampleSize);
+    selectPopulationTo(m_samples, m_sampleGenomes, m_sampleSize);
 
-    std::for_each(m_samples.begin(), m_samples.end(), [this](const auto &s) {
-        this->m_samplesFitnessSum += s->getSnakeModel()->getRank();
-    });
+    m_samplesFitnessSum = m_pool->parallelReduce(
+        0, m_samples.size(), c_cheapJobGrain, (long double)0,
+        [this](int i) { return m_samples[i].fitness; },
+        [](long double a, long double b) { return a + b; });
 }
 
 void TrainApp::crossover() {
-    std::string result;
-    std::string label = fmt::format("GA: generation = {} crossover", m_generation);
+    std::pmr::string result(utility::memory::generationResource());
+    auto label = utility::memory::format("GA: generation = {} crossover", m_generation);
 
     utility::time::measure(label, result, [&]() {
         this->crossoverImpl();
@@ -240,88 +1114,78 @@ void TrainApp::crossoverImpl() {
     m_population.clear();
 
     // add the samples to next generation without reduce the crossover population size.
-    // next generation should be AppConfig::PopulationSize() + m_sampleSize;
-    // crossoverSize = AppConfig::PopulationSize()
-    m_populationSize = AppConfig::PopulationSize() + m_sampleSize;
+    // next generation should be m_targetPopulation + m_sampleSize;
+    // crossoverSize = m_targetPopulation, AppConfig::PopulationSize() unless the generation budget changed it
+    m_populationSize = m_targetPopulation + m_sampleSize;
     m_population.reserve(m_populationSize);
 
-    for (int i = 0; i < m_populationSize; i++) {
-        m_population.push_back(std::make_shared<SnakeApp>());
-    }
+    m_population.resize(m_populationSize);
+    m_genomes.resize(m_populationSize);
 
+    // keepElites: the samples go on unchanged in the last eliteSize slots, neither crossed nor mutated
     int eliteSize = m_sampleSize;
-    int crossoverSize = m_populationSize;
+    int crossoverSize = AppConfig::KeepElites() ? m_populationSize - eliteSize : m_populationSize;
+    m_eliteCount = m_populationSize - crossoverSize;
+    const int genomeSize = m_genomes.genomeSize();
+    const uint32_t firstId = m_nextId;
+    m_nextId += m_populationSize;
 
     //杂交产生后代
-    std::for_each(m_population.begin(), m_population.begin() + crossoverSize, [this](const auto &s) {
-        m_pool->queueJob([&]() {
-            ///////////////////////////////
-            int parentIndex1 = RouletteWheelSelection(this->m_samples, this->m_samplesFitnessSum);
-            int parentIndex2 = RouletteWheelSelection(this->m_samples, this->m_samplesFitnessSum);
-            while ((parentIndex1 == parentIndex2) && (parentIndex2 = RouletteWheelSelection(m_samples, this->m_samplesFitnessSum)))
-                ;
-            ///////////////////////////////
-            auto topology = s->getSnakeModel()->getBrain()->getNeuralNetwork()->getTopology();
-            int weightMatrixNum = topology.size() - 1;
-            for (int weightIndex = 0; weightIndex < weightMatrixNum; weightIndex++) {
-
-                std::shared_ptr<Matrix> weight = s->getSnakeModel()->getBrain()->getNeuralNetwork()->weightMatrixAt(weightIndex);
-
-                for (int i = 0; i < weight->getRowNum(); i++) {
-                    for (int j = 0; j < weight->getColNum(); j++) {
-
-                        double d = utility::random::generateRandomDouble(0, 1);
-                        double newValue = 0.0;
-                        if (d > 0.5) {
-                            newValue = m_samples[parentIndex1]->getSnakeModel()->getBrain()->getNeuralNetwork()->weightMatrixAt(weightIndex)->getValue(i, j);
-                        } else {
-                            newValue = m_samples[parentIndex2]->getSnakeModel()->getBrain()->getNeuralNetwork()->weightMatrixAt(weightIndex)->getValue(i, j);
-                        }
-
-                        weight->setValue(i, j, newValue);
-                    }
-                }
-            }
-
-            s->getSnakeModel()->setCrossoverFlag(true);
-            ///////////////////////////////
-        });
-    });
+    m_pool->parallelFor(0, crossoverSize, c_breedJobGrain, [this, genomeSize, firstId](int index) {
+        reseed(RandomStream::crossover, index);
+        ///////////////////////////////
+        // two different parents, drawn again while the wheel misses (-1) or repeats
+        // the first. a wheel that keeps missing, every fitness 0, takes neighbours
+        const int sampleNum = m_samples.size();
+        int parentIndex1 = RouletteWheelSelection(this->m_samples, this->m_samplesFitnessSum);
+        for (int draw = 1; parentIndex1 < 0 && draw < c_parentDraws; draw++) {
+            parentIndex1 = RouletteWheelSelection(this->m_samples, this->m_samplesFitnessSum);
+        }
+        if (parentIndex1 < 0) {
+            parentIndex1 = 0;
+        }
 
-    std::string result;
-    std::string label = fmt::format("GA: generation = {} waitCrossover", m_generation);
+        int parentIndex2 = RouletteWheelSelection(this->m_samples, this->m_samplesFitnessSum);
+        for (int draw = 1; (parentIndex2 < 0 || parentIndex2 == parentIndex1) && draw < c_parentDraws; draw++) {
+            parentIndex2 = RouletteWheelSelection(this->m_samples, this->m_samplesFitnessSum);
+        }
+        if (parentIndex2 < 0 || parentIndex2 == parentIndex1) {
+            parentIndex2 = sampleNum > 1 ? (parentIndex1 + 1) % sampleNum : parentIndex1;
+        }
+        ///////////////////////////////
+        const ga::Individual &parent1 = m_samples[parentIndex1];
+        const ga::Individual &parent2 = m_samples[parentIndex2];
+        const double *genome1 = m_sampleGenomes.at(parent1.genome);
+        const double *genome2 = m_sampleGenomes.at(parent2.genome);
+        double *genome = m_genomes.at(index);
+
+        for (int w = 0; w < genomeSize; w++) {
+            double d = utility::random::generateRandomDouble(0, 1);
+            genome[w] = d > 0.5 ? genome1[w] : genome2[w];
+        }
 
-    utility::time::measure(label, result, [&]() {
-        waitCrossover(crossoverSize);
+        // LPT scheduling hint for the next evaluate: the parents' lifetimes
+        m_population[index] = ga::Individual{firstId + index, {parent1.id, parent2.id}, index, 0, 0, 0,
+                                             (parent1.totalSteps + parent2.totalSteps) / 2, 0, 0};
+        ///////////////////////////////
     });
 
-    LOG(INFO) << result;
-
     //精英直接保留
-    for (int pIndex = crossoverSize, eIndex = 0; pIndex < m_populationSize && eIndex < eliteSize; pIndex++, eIndex++) {
+    m_pool->parallelFor(0, std::min(eliteSize, m_populationSize - crossoverSize), c_breedJobGrain, [this, crossoverSize, genomeSize](int eIndex) {
+        int pIndex = crossoverSize + eIndex;
 
         /////////////////////////
-        auto topology = m_population[pIndex]->getSnakeModel()->getBrain()->getNeuralNetwork()->getTopology();
-        int weightMatrixNum = topology.size() - 1;
-
-        for (int weightIndex = 0; weightIndex < weightMatrixNum; weightIndex++) {
-
-            std::shared_ptr<Matrix> weight = m_population[pIndex]->getSnakeModel()->getBrain()->getNeuralNetwork()->weightMatrixAt(weightIndex);
-            std::shared_ptr<Matrix> eliteWeight = m_samples[eIndex]->getSnakeModel()->getBrain()->getNeuralNetwork()->weightMatrixAt(weightIndex);
-
-            for (int i = 0; i < weight->getRowNum(); i++) {
-                for (int j = 0; j < weight->getColNum(); j++) {
-                    weight->setValue(i, j, eliteWeight->getValue(i, j));
-                }
-            }
-        }
+        std::copy_n(m_sampleGenomes.at(m_samples[eIndex].genome), genomeSize, m_genomes.at(pIndex));
+        m_population[pIndex] = m_samples[eIndex];
+        m_population[pIndex].genome = pIndex;
+        m_population[pIndex].expectedSteps = m_samples[eIndex].totalSteps;
         /////////////////////////
-    }
+    });
 }
 
 void TrainApp::mutate() {
-    std::string result;
-    std::string label = fmt::format("GA: generation = {} mutate", m_generation);
+    std::pmr::string result(utility::memory::generationResource());
+    auto label = utility::memory::format("GA: generation = {} mutate", m_generation);
 
     utility::time::measure(label, result, [this]() {
         this->mutateImpl();
@@ -332,11 +1196,34 @@ void TrainApp::mutate() {
 
 void TrainApp::mutateImpl() {
 
-    std::for_each(m_population.begin(), m_population.end(), [this](const auto &s) {
-        s->getSnakeModel()->getBrain()->mutate(m_mutateValueTable);
+    const int genomeSize = m_genomes.genomeSize();
+    m_pool->parallelFor(0, m_population.size() - m_eliteCount, c_breedJobGrain, [this, genomeSize](int i) {
+        reseed(RandomStream::mutate, i);
+        ga::mutate(m_genomes.at(m_population[i].genome), genomeSize, m_mutateValueTable);
     });
 }
 
+void TrainApp::initThreadPool() {
+
+    m_cpuTopology = CpuTopology::detect();
+
+    int threadNum = AppConfig::TrainingThreadNum();
+    if (threadNum <= 0) {
+        threadNum = m_cpuTopology.effectiveCpuNum();
+    }
+
+    ThreadAffinity affinity = ThreadAffinity::fromString(AppConfig::TrainingThreadAffinity());
+    m_pool = new ThreadPool(threadNum, m_cpuTopology.pinOrder(affinity, threadNum));
+
+    LOG(INFO) << "CPU topology: " << m_cpuTopology.description();
+    LOG(INFO) << fmt::format("ThreadPool: threads = {}, affinity = {}, pinned cpus = {}",
+                             m_pool->size(),
+                             affinity.description(),
+                             m_pool->pinnedCpus());
+
+    fmt::print("ThreadPool: {} threads, affinity = {} ({})\n", m_pool->size(), affinity.description(), m_cpuTopology.description());
+}
+
 void TrainApp::initMutateTable() {
 
     std::string result;
@@ -360,16 +1247,40 @@ void TrainApp::initPopulation() {
     std::string label = fmt::format("GA: generation = {} initPopulation", m_generation);
 
     utility::time::measure(label, result, [&]() {
+        m_ioNetwork = std::make_unique<NeuralNetwork>(m_settings->topology);
+        m_genomes = ga::GenomeStore(m_settings->topology, m_populationSize);
+        m_sampleGenomes = ga::GenomeStore(m_settings->topology, 0);
+
         m_population.reserve(m_populationSize);
         m_population.clear();
 
         for (int i = 0; i < m_populationSize; i++) {
-            auto s = std::make_shared<SnakeApp>();
-            m_population.push_back(s);
+            m_population.push_back(ga::Individual{m_nextId++, {ga::Individual::c_noParent, ga::Individual::c_noParent}, i, 0, 0, 0, 0, 0, 0});
         }
     });
 
     LOG(INFO) << result;
+
+    std::string memory = memoryReport();
+    LOG(INFO) << memory;
+    fmt::print("{}\n", memory);
+}
+
+std::string TrainApp::memoryReport() {
+    // what grows with the population, and the per thread part that does not
+    size_t record = sizeof(ga::Individual);
+    size_t genome = m_genomes.genomeSize() * sizeof(double);
+    size_t population = m_population.capacity() * record + m_genomes.bytes();
+    size_t samples = m_samples.capacity() * record + m_sampleGenomes.bytes();
+    size_t contexts = 0;
+    for (const auto &c : m_contexts) {
+        contexts += c->approxBytes();
+    }
+
+    return fmt::format("Population memory: {} individuals, {} bytes each ({} record + {} genome), population {:.1f} MB, samples {:.1f} MB, contexts {:.1f} MB, parked games {}, generation arenas {:.1f} MB ({:.1f} MB past them so far)",
+                       m_population.size(), record + genome, record, genome,
+                       population / 1048576.0, samples / 1048576.0, contexts / 1048576.0, m_parkedGames.size(),
+                       utility::memory::arenaBytes() / 1048576.0, utility::memory::overflowBytes() / 1048576.0);
 }
 
 void TrainApp::initSamples() {
@@ -385,76 +1296,37 @@ void TrainApp::initSamples() {
     LOG(INFO) << result;
 }
 
-bool TrainApp::waitDieOut() {
-
-    int checkCount = 0;
-    bool natureRunning = true;
-
-    while (natureRunning) {
-        checkCount++;
-
-        int aliveCount = m_population.size();
-        for (auto &snakeApp : m_population) {
-            if (snakeApp->getState().isEnd()) {
-                aliveCount--;
-            } else {
-#if 0
-                // disable high frequency log temporarily
-                LOG(INFO) << fmt::format("checking alive snake, totalStepCount = {}, eatStepCount = {}, score = {}",
-                                         snakeApp->getSnakeModel()->getTotalStepCount(),
-                                         snakeApp->getSnakeModel()->getEatStepCount(),
-                                         snakeApp->getSnakeModel()->getScore());
-#endif
-            }
-        }
-
-        if (0 == aliveCount) {
-            natureRunning = false;
-            break;
-        }
-
-        auto sleepTime = std::chrono::milliseconds(5);
-        std::this_thread::sleep_for(sleepTime);
-    }
-
-    return true;
+uint64_t TrainApp::streamKey(RandomStream stream, int generation, long long index) {
+    auto mix = [](uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    };
+    uint64_t key = mix(uint64_t(stream));
+    key = mix(key ^ uint64_t(uint32_t(generation)));
+    return mix(key ^ uint64_t(index));
 }
 
-bool TrainApp::waitCrossover(int crossoverCount) {
-
-    int checkCount = 0;
-    bool checking = true;
-
-    while (checking) {
-        checkCount++;
-
-        int counter = crossoverCount;
-        for (int i = 0; i < crossoverCount; i++) {
-            if (m_population[i]->getSnakeModel()->getCrossoverFlag()) {
-                counter--;
-            }
-        }
-
-        if (0 == counter) {
-            checking = false;
-            break;
-        }
+void TrainApp::reseed(RandomStream stream, long long index) {
+    reseed(stream, m_generation, index);
+}
 
-        auto sleepTime = std::chrono::milliseconds(5);
-        std::this_thread::sleep_for(sleepTime);
+void TrainApp::reseed(RandomStream stream, int generation, long long index) {
+    if (m_masterSeed == 0) {
+        return;
     }
-
-    return true;
+    utility::random::seed(m_masterSeed, streamKey(stream, generation, index));
 }
 
-int TrainApp::RouletteWheelSelection(const std::vector<std::shared_ptr<SnakeApp>> &population, const long double &fitnessSum) {
+int TrainApp::RouletteWheelSelection(const std::vector<ga::Individual> &population, const long double &fitnessSum) {
 
     long double slice = utility::random::generateRandomDouble(0, 1) * fitnessSum;
     long double total = 0.0;
     int selectedIndex = -1;
     int size = population.size();
     for (int i = 0; i < size; i++) {
-        total += population[i]->getSnakeModel()->getRank();
+        total += population[i].fitness;
 
         if (total > slice) {
             selectedIndex = i;
@@ -467,7 +1339,7 @@ int TrainApp::RouletteWheelSelection(const std::vector<std::shared_ptr<SnakeApp>
 
 void TrainApp::saveSamples() {
 
-    saveTrainingResults(m_samples, m_generation);
+    saveTrainingResults(m_samples, m_sampleGenomes, m_generation);
 
     updateLatestSaveGenInfo(m_generation);
     updateLatestNNFile(m_generation);
@@ -507,9 +1379,14 @@ void TrainApp::tryRestoreLastTraining() {
 
     } else {
         // new training task
-        // set the weights to random value
+        // set the weights to random value, uniform in [0, 1) like Matrix::fillWithRandom
+        const int genomeSize = m_genomes.genomeSize();
         for (int i = 0; i < m_populationSize; i++) {
-            m_population[i]->getSnakeModel()->getBrain()->getNeuralNetwork()->setWeightMatricesWithRandomValue();
+            reseed(RandomStream::initialWeights, i);
+            double *genome = m_genomes.at(m_population[i].genome);
+            for (int w = 0; w < genomeSize; w++) {
+                genome[w] = utility::random::generateRandomDouble(0, 1);
+            }
         }
 
         LOG(INFO) << "not found exist task, new training task";
@@ -521,9 +1398,7 @@ void TrainApp::restoreFromSavedSamples() {
     // init m_samples
     LOG(INFO) << "restoreFromSavedSamples init m_samples.";
     m_samples.clear();
-    for (int i = 0; i < m_sampleSize; i++) {
-        m_samples.push_back(std::make_shared<SnakeApp>());
-    }
+    m_sampleGenomes.resize(m_sampleSize);
 
     // load sample files.
     LOG(INFO) << "restoreFromSavedSamples load sample files.";
@@ -535,16 +1410,23 @@ void TrainApp::restoreFromSavedSamples() {
         auto fileURI = genDir / fs::path(filename);
         auto fileURIStr = fileURI.string();
 
-        m_samples[i]->getSnakeModel()->getBrain()->getNeuralNetwork()->loadNeuralNetwork(fileURIStr);
-        json nnDescription = m_samples[i]->getSnakeModel()->getBrain()->getNeuralNetwork()->getDescription();
+        NeuralNetwork nn(fileURIStr);
+        ga::copyFromNetwork(nn, m_sampleGenomes.at(i));
+        json nnDescription = nn.getDescription();
 
         long double fitness = nnDescription["fitness"];
 
         // RouletteWheelSelection need fitness and sum
         this->m_samplesFitnessSum += fitness;
-        m_samples[i]->getSnakeModel()->setRank(fitness);
+        m_samples.push_back(ga::Individual{m_nextId++, {ga::Individual::c_noParent, ga::Individual::c_noParent}, i,
+                                           nnDescription.value("score", 0), nnDescription.value("stepCount", 0), 0, 0,
+                                           nnDescription.value("seed", 0u), fitness});
     }
 
+    // breed as the saved generation, a continuous run breeds the next population
+    // at the end of it and reseed() draws from the generation it breeds in
+    m_generation = AppConfig::LatestSaveGeneration();
+
     // crossover make the population
     LOG(INFO) << "restoreFromSavedSamples crossover make the population.";
     this->crossover();
@@ -564,12 +1446,10 @@ void TrainApp::reportGenerationInfo(int generation) {
 
     LOG(INFO) << fmt::format("====================== Generation Report: {:05} ========================\n", generation);
 
-    double genScoreSum = 0;
-    double genFitnessSum = 0;
-    std::for_each(m_population.begin(), m_population.end(), [&genScoreSum, &genFitnessSum](const auto &s) {
-        genFitnessSum += s->getSnakeModel()->getRank();
-        genScoreSum += s->getSnakeModel()->getScore();
-    });
+    double genScoreSum = m_pool->parallelReduce(
+        0, m_population.size(), c_cheapJobGrain, 0.0,
+        [this](int i) { return double(m_population[i].score); },
+        [](double a, double b) { return a + b; });
 
     LOG(INFO) << fmt::format("generation {} - avg_score = {}\n",
                              generation,
@@ -577,16 +1457,22 @@ void TrainApp::reportGenerationInfo(int generation) {
 
     LOG(INFO) << fmt::format("top 3:\n");
     std::for_each(m_population.begin(), m_population.begin() + 3, [](const auto &s) {
-        LOG(INFO) << fmt::format("fitness = {}, score = {}, step = {}\n",
-                                 s->getSnakeModel()->getRank(),
-                                 s->getSnakeModel()->getScore(),
-                                 s->getSnakeModel()->getTotalStepCount());
+        LOG(INFO) << fmt::format("fitness = {}, score = {}, step = {}, id = {}, parents = {}/{}, seed = {}\n",
+                                 s.fitness,
+                                 s.score,
+                                 s.totalSteps,
+                                 s.id,
+                                 int(s.parents[0]),
+                                 int(s.parents[1]),
+                                 s.seed);
     });
 
+    LOG(INFO) << memoryReport();
+
     LOG(INFO) << fmt::format("======================== Generation Report End =========================\n");
 }
 
-void TrainApp::buildTrainingInfo(json &authorInfo, const std::shared_ptr<SnakeApp> &snakeApp) {
+void TrainApp::buildTrainingInfo(json &authorInfo, const ga::Individual &individual) {
 
     std::time_t t = std::time(nullptr);
     std::string create = fmt::format("{:%Y-%m-%d %H:%M:%S}", fmt::localtime(t));
@@ -595,9 +1481,11 @@ void TrainApp::buildTrainingInfo(json &authorInfo, const std::shared_ptr<SnakeAp
     authorInfo["sampleSize"] = m_sampleSize;
     authorInfo["generation"] = m_generation;
 
-    authorInfo["fitness"] = snakeApp->getSnakeModel()->getRank();
-    authorInfo["score"] = snakeApp->getSnakeModel()->getScore();
-    authorInfo["stepCount"] = snakeApp->getSnakeModel()->getTotalStepCount();
+    authorInfo["fitness"] = individual.fitness;
+    authorInfo["score"] = individual.score;
+    authorInfo["stepCount"] = individual.totalSteps;
+    authorInfo["seed"] = individual.seed;
+    authorInfo["games"] = AppConfig::EvaluationGames();
 
     authorInfo["create"] = create;
 }
@@ -635,15 +1523,19 @@ void TrainApp::createGenerationDir(int gen, fs::path &generationDir) {
     }
 }
 
-void TrainApp::selectPopulationTo(std::vector<std::shared_ptr<SnakeApp>> &target, int size) {
+void TrainApp::selectPopulationTo(std::vector<ga::Individual> &target, ga::GenomeStore &targetGenomes, int size) {
     target.clear();
+    targetGenomes.resize(size);
 
-    std::for_each(m_population.begin(), m_population.begin() + size, [&target](const auto &s) {
+    // the genomes are copied, crossover writes the next population over them
+    std::for_each(m_population.begin(), m_population.begin() + size, [&](const auto &s) {
+        std::copy_n(m_genomes.at(s.genome), m_genomes.genomeSize(), targetGenomes.at(target.size()));
         target.push_back(s);
+        target.back().genome = target.size() - 1;
     });
 }
 
-void TrainApp::saveTrainingResults(const std::vector<std::shared_ptr<SnakeApp>> &src, int gen) {
+void TrainApp::saveTrainingResults(const std::vector<ga::Individual> &src, const ga::GenomeStore &genomes, int gen) {
 
     fs::path genDir;
     createTrainingTaskDir();
@@ -659,8 +1551,9 @@ void TrainApp::saveTrainingResults(const std::vector<std::shared_ptr<SnakeApp>>
 
         this->buildTrainingInfo(trainingInfo, src[i]);
 
-        src[i]->getSnakeModel()->getBrain()->getNeuralNetwork()->setDescription(trainingInfo);
-        src[i]->getSnakeModel()->getBrain()->getNeuralNetwork()->saveNeuralNetwork(fileURI.string());
+        ga::copyToNetwork(genomes.at(src[i].genome), *m_ioNetwork);
+        m_ioNetwork->setDescription(trainingInfo);
+        m_ioNetwork->saveNeuralNetwork(fileURI.string());
     }
 }
 
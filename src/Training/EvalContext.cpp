@@ -0,0 +1,27 @@
+#include "Training/EvalContext.h"
+
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Training/Genome.h"
+
+namespace ga {
+
+    EvalContext::EvalContext(const GameSettings &settings, int inferenceLanes, bool loopDetection)
+        : m_game(settings.row, settings.col, settings.wanderThreshold),
+          m_genomeSize(genomeSize(settings.topology)) {
+        m_game.setLoopDetection(loopDetection);
+        if (inferenceLanes > 0) {
+            m_lanes = std::make_unique<sim::LaneEvaluator>(inferenceLanes, settings.row, settings.col, settings.wanderThreshold, *m_brain.getNeuralNetwork());
+            m_lanes->setLoopDetection(loopDetection);
+        }
+    }
+
+    void EvalContext::loadGenome(const double *genome) {
+        copyToNetwork(genome, *m_brain.getNeuralNetwork());
+    }
+
+    size_t EvalContext::approxBytes() const {
+        const int networks = 1 + (m_lanes ? m_lanes->laneNum() : 0);
+        return sizeof(EvalContext) + sizeof(SnakeBrain) + networks * m_genomeSize * sizeof(double);
+    }
+
+} // namespace ga
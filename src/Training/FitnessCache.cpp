@@ -0,0 +1,37 @@
+#include "Training/FitnessCache.h"
+
+namespace ga {
+
+    uint64_t FitnessCache::key(uint64_t genomeHash, uint64_t seedSet) {
+        uint64_t x = genomeHash ^ (seedSet + 0x9e3779b97f4a7c15ULL + (genomeHash << 6) + (genomeHash >> 2));
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    void FitnessCache::nextGeneration() {
+        m_previous.swap(m_current);
+        m_current.clear();
+    }
+
+    bool FitnessCache::lookup(uint64_t key, Result &result) {
+        auto it = m_current.find(key);
+        if (it != m_current.end()) {
+            result = it->second;
+            return true;
+        }
+
+        auto old = m_previous.find(key);
+        if (old == m_previous.end()) {
+            return false;
+        }
+        result = old->second;
+        m_current.emplace(key, result);
+        return true;
+    }
+
+    void FitnessCache::insert(uint64_t key, const Result &result) {
+        m_current[key] = result;
+    }
+
+} // namespace ga
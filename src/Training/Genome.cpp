@@ -0,0 +1,73 @@
+#include "Training/Genome.h"
+
+#include "NeuralNetwork/NeuralNetwork.h"
+#include "Utility.h"
+#include <cstring>
+
+namespace ga {
+
+    int genomeSize(const std::vector<int> &topology) {
+        int size = 0;
+        for (size_t i = 0; i + 1 < topology.size(); i++) {
+            size += topology[i] * topology[i + 1];
+        }
+        return size;
+    }
+
+    void copyFromNetwork(NeuralNetwork &nn, double *genome) {
+        const int matrixNum = nn.getTopology().size() - 1;
+        for (int m = 0; m < matrixNum; m++) {
+            Matrix &weight = *nn.weightMatrixAt(m);
+            for (int i = 0; i < weight.getRowNum(); i++) {
+                for (int j = 0; j < weight.getColNum(); j++) {
+                    *genome++ = weight.getValue(i, j);
+                }
+            }
+        }
+    }
+
+    void copyToNetwork(const double *genome, NeuralNetwork &nn) {
+        const int matrixNum = nn.getTopology().size() - 1;
+        for (int m = 0; m < matrixNum; m++) {
+            Matrix &weight = *nn.weightMatrixAt(m);
+            for (int i = 0; i < weight.getRowNum(); i++) {
+                for (int j = 0; j < weight.getColNum(); j++) {
+                    weight.setValue(i, j, *genome++);
+                }
+            }
+        }
+    }
+
+    void mutate(double *genome, int genomeSize, const std::vector<double> &mutateValueTable) {
+        for (int counter = 0; counter < genomeSize; counter++) {
+            int random = utility::random::generateRandomNumber(0, genomeSize - 1);
+            int mutateValueIndex = utility::random::generateRandomNumber(0, mutateValueTable.size() - 1);
+            genome[random] = genome[random] + mutateValueTable[mutateValueIndex];
+        }
+    }
+
+    uint64_t genomeHash(const double *genome, int genomeSize) {
+        // FNV-1a over the 64 bit words, then a splitmix64 finalizer
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (int i = 0; i < genomeSize; i++) {
+            uint64_t bits;
+            std::memcpy(&bits, &genome[i], sizeof(bits));
+            hash = (hash ^ bits) * 0x100000001b3ULL;
+        }
+        hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+        return hash ^ (hash >> 31);
+    }
+
+    GenomeStore::GenomeStore(const std::vector<int> &topology, int count)
+        : m_topology(topology),
+          m_genomeSize(ga::genomeSize(topology)) {
+        resize(count);
+    }
+
+    void GenomeStore::resize(int count) {
+        m_count = count;
+        m_values.resize(size_t(count) * m_genomeSize, 0.0);
+    }
+
+} // namespace ga
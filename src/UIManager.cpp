@@ -90,40 +90,40 @@ void UIManager::onEvent() {
     while (SDL_PollEvent(&event) != 0) {
         if (event.type == SDL_QUIT) {
             LOG(INFO) << "SDL_QUIT Event received, now exit.";
-            this->notify(*this, "quit");
+            this->notify(*this, UIEvent::quit);
         }
 
         if (event.type == SDL_KEYDOWN) {
             switch (event.key.keysym.scancode) {
             case SDL_SCANCODE_DOWN:
             case SDL_SCANCODE_S:
-                this->notify(*this, "down");
+                this->notify(*this, UIEvent::down);
                 break;
             case SDL_SCANCODE_UP:
             case SDL_SCANCODE_W:
-                this->notify(*this, "up");
+                this->notify(*this, UIEvent::up);
                 break;
             case SDL_SCANCODE_RIGHT:
             case SDL_SCANCODE_D:
-                this->notify(*this, "right");
+                this->notify(*this, UIEvent::right);
                 break;
             case SDL_SCANCODE_LEFT:
             case SDL_SCANCODE_A:
-                this->notify(*this, "left");
+                this->notify(*this, UIEvent::left);
                 break;
 
             case SDL_SCANCODE_P:
-                this->notify(*this, "onPKeyPressed");
+                this->notify(*this, UIEvent::onPKeyPressed);
                 break;
 
             case SDL_SCANCODE_Q:
-                this->notify(*this, "onQKeyPressed");
+                this->notify(*this, UIEvent::onQKeyPressed);
                 break;
             case SDL_SCANCODE_R:
-                this->notify(*this, "onRKeyPressed");
+                this->notify(*this, UIEvent::onRKeyPressed);
                 break;
             case SDL_SCANCODE_SPACE:
-                this->notify(*this, "onSpacePressed");
+                this->notify(*this, UIEvent::onSpacePressed);
                 break;
 
             default:
@@ -350,25 +350,25 @@ void UIManager::drawApple() {
     m_appleEntity->getTexturedRectangle().setRectangleMode(RectangleMode::fill);
 }
 
-void UIManager::field_changed(InfoboardModel &source, const string &field_name) {
-    if (field_name == "scoreStr") {
+void UIManager::field_changed(InfoboardModel &source, InfoboardEvent::Type event) {
+    if (event == InfoboardEvent::scoreStr) {
         m_scoreLabel->setText(source.getScoreStr());
-    } else if (field_name == "stepCountStr") {
+    } else if (event == InfoboardEvent::stepCountStr) {
         m_stepCountLabel->setText(source.getStepCountStr());
-    } else if (field_name == "refreshTimeStr") {
+    } else if (event == InfoboardEvent::refreshTimeStr) {
         m_refreshTimeLabel->setText(source.getRefreshTimeStr());
-    } else if (field_name == "directionStr") {
+    } else if (event == InfoboardEvent::directionStr) {
         m_nextDirectionLabel->setText(source.getDirectionStr());
-    } else if (field_name == "gameStateStr") {
+    } else if (event == InfoboardEvent::gameStateStr) {
         m_gameStateLabel->setText(source.getGameStateStr());
 
-    } else if (field_name == "gameCommandStr") {
+    } else if (event == InfoboardEvent::gameCommandStr) {
         m_keyInfoLabel->setText(source.getGameCommandStr());
-    } else if (field_name == "infoStr") {
+    } else if (event == InfoboardEvent::infoStr) {
 
         m_infoLabel->setText(source.getInfoStr());
 
-    } else if (field_name == "nextDirectionStr") {
+    } else if (event == InfoboardEvent::nextDirectionStr) {
 
         if (AppConfig::RunMode().isAIMode()) {
 
@@ -382,15 +382,15 @@ void UIManager::field_changed(InfoboardModel &source, const string &field_name)
             m_rightValueLabel->setText(source.getRightValueStr());
         }
 
-    } else if (field_name == "fpsStr") {
+    } else if (event == InfoboardEvent::fpsStr) {
         m_FPSLabel->setText(source.getFPSStr());
     } else {
     }
 }
 
-void UIManager::field_changed(PlayboardModel &source, const string &field_name) {
+void UIManager::field_changed(PlayboardModel &source, PlayboardEvent::Type event) {
 
-    if (field_name == "placeApple") {
+    if (event == PlayboardEvent::placeApple) {
 
         int apple_x = source.getApplePosition().col * AppConfig::SnakeBlockWidth() + AppConfig::Margin();
         int apple_y = source.getApplePosition().row * AppConfig::SnakeBlockHeight() + AppConfig::Margin();
@@ -398,7 +398,7 @@ void UIManager::field_changed(PlayboardModel &source, const string &field_name)
         m_appleEntity->setPosition(apple_x, apple_y);
         m_appleEntity->setDimensions(AppConfig::SnakeBlockWidth(), AppConfig::SnakeBlockHeight());
 
-    } else if (field_name == "eraseApple") {
+    } else if (event == PlayboardEvent::eraseApple) {
 
         m_appleEntity->setDimensions(0, 0);
 
@@ -406,9 +406,9 @@ void UIManager::field_changed(PlayboardModel &source, const string &field_name)
     }
 }
 
-void UIManager::field_changed(SnakeModel &source, const string &field_name) {
+void UIManager::field_changed(SnakeModel &source, SnakeEvent::Type event) {
 
-    if (field_name == "addHeadBlock") {
+    if (event == SnakeEvent::addHeadBlock) {
 
         std::shared_ptr<Entity> piece_entity =
             EntityManager::getInstance().createEntity(m_renderer, EntityLayer::FOREGROUND);
@@ -425,7 +425,7 @@ void UIManager::field_changed(SnakeModel &source, const string &field_name) {
 
         m_snakeBodyEntityQueue.push_front(piece_entity);
 
-    } else if (field_name == "removeTailBlock") {
+    } else if (event == SnakeEvent::removeTailBlock) {
 
         if (m_snakeBodyEntityQueue.size() > 0) {
 
@@ -439,7 +439,7 @@ void UIManager::field_changed(SnakeModel &source, const string &field_name) {
             }
         }
 
-    } else if (field_name == "nextDirection") {
+    } else if (event == SnakeEvent::nextDirection) {
 
         if (AppConfig::RunMode().isAIMode()) {
             std::vector<std::shared_ptr<TextLabel>> vec{
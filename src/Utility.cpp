@@ -1,6 +1,12 @@
 #include "Utility.h"
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
+#include <glog/logging.h>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace uuid {
     static std::random_device rd;
@@ -40,11 +46,19 @@ namespace uuid {
 namespace utility {
     namespace random {
         static std::random_device dev;
+        static std::mutex devMutex;
+
+        static unsigned int seedFromDevice() {
+            std::lock_guard<std::mutex> lock(devMutex);
+            return dev();
+        }
+
         //随机数发生器
         // mt19937 随机效果好，但是慢
         // minstd_rand 随机效果比不上mt19937，但是快很多
-        static std::mt19937 mt19937_rng(dev());
-        static std::minstd_rand minstd_rng(dev());
+        // one generator per thread, GA stages call these from pool workers concurrently
+        static thread_local std::mt19937 mt19937_rng(seedFromDevice());
+        static thread_local std::minstd_rand minstd_rng(seedFromDevice());
 
         int generateRandomNumber(int low, int high) {
 #if 0
@@ -66,11 +80,130 @@ namespace utility {
 #endif
         }
 
+        void seed(unsigned int value) {
+            mt19937_rng.seed(value);
+            minstd_rng.seed(value);
+        }
+
+        void seed(uint64_t master, uint64_t stream) {
+            // splitmix64 of both. only the generator the draws use, seeding mt19937 costs more than a task
+            uint64_t x = master + 0x9e3779b97f4a7c15ULL * (stream + 1);
+            x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+            x = x ^ (x >> 31);
+            minstd_rng.seed(std::minstd_rand::result_type(x % (std::minstd_rand::modulus - 1) + 1));
+        }
+
     } // namespace random
 
     namespace memory {
+        static std::atomic<unsigned long long> s_arenaBytes{0};
+        static std::atomic<unsigned long long> s_overflowBytes{0};
 
-    }
+        static constexpr size_t c_initialBlockSize = 64 * 1024;
+
+        // the global allocator behind an arena, what it hands out is counted
+        class OverflowResource : public std::pmr::memory_resource {
+        public:
+            size_t bytes = 0;
+
+        private:
+            void *do_allocate(size_t size, size_t alignment) override {
+                bytes += size;
+                s_overflowBytes.fetch_add(size, std::memory_order_relaxed);
+                return std::pmr::new_delete_resource()->allocate(size, alignment);
+            }
+            void do_deallocate(void *p, size_t size, size_t alignment) override {
+                std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+            }
+            bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+#ifdef DEBUG_BINARY
+        // the arena with its allocations counted, a reset with any of them alive would free them under their owner
+        class LiveCountResource : public std::pmr::memory_resource {
+        public:
+            explicit LiveCountResource(std::pmr::memory_resource *upstream) : m_upstream(upstream) {}
+            long long live = 0;
+
+        private:
+            void *do_allocate(size_t size, size_t alignment) override {
+                live++;
+                return m_upstream->allocate(size, alignment);
+            }
+            void do_deallocate(void *p, size_t size, size_t alignment) override {
+                live--;
+                m_upstream->deallocate(p, size, alignment);
+            }
+            bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+                return this == &other;
+            }
+
+            std::pmr::memory_resource *m_upstream;
+        };
+#endif
+
+        class GenerationArena {
+        public:
+            GenerationArena() { reset(); }
+            ~GenerationArena() { s_arenaBytes.fetch_sub(m_block.size(), std::memory_order_relaxed); }
+
+#ifdef DEBUG_BINARY
+            std::pmr::memory_resource *resource() { return &*m_counted; }
+#else
+            std::pmr::memory_resource *resource() { return &*m_resource; }
+#endif
+
+            void reset() {
+#ifdef DEBUG_BINARY
+                if (m_counted && m_counted->live != 0) {
+                    LOG(FATAL) << "Generation arena reset with " << m_counted->live << " allocations alive";
+                }
+                m_counted.reset();
+#endif
+                // destroying the resource returns what it took past the block
+                m_resource.reset();
+
+                size_t size = std::max(c_initialBlockSize, m_block.size());
+                if (m_overflow.bytes > 0) {
+                    size = std::max(2 * size, size + m_overflow.bytes);
+                }
+                if (size != m_block.size()) {
+                    s_arenaBytes.fetch_add(size - m_block.size(), std::memory_order_relaxed);
+                    m_block.resize(size);
+                }
+                m_overflow.bytes = 0;
+
+                m_resource.emplace(m_block.data(), m_block.size(), &m_overflow);
+#ifdef DEBUG_BINARY
+                m_counted.emplace(&*m_resource);
+#endif
+            }
+
+        private:
+            std::vector<std::byte> m_block;
+            OverflowResource m_overflow;
+            std::optional<std::pmr::monotonic_buffer_resource> m_resource;
+#ifdef DEBUG_BINARY
+            std::optional<LiveCountResource> m_counted;
+#endif
+        };
+
+        static GenerationArena &threadArena() {
+            static thread_local GenerationArena arena;
+            return arena;
+        }
+
+        std::pmr::memory_resource *generationResource() { return threadArena().resource(); }
+
+        void resetArena() { threadArena().reset(); }
+
+        unsigned long long arenaBytes() { return s_arenaBytes.load(std::memory_order_relaxed); }
+        unsigned long long overflowBytes() { return s_overflowBytes.load(std::memory_order_relaxed); }
+
+    } // namespace memory
 
     namespace time {
         void measure(const std::string &label, std::string &result, std::function<void()> const &lambda) {
@@ -86,6 +219,35 @@ namespace utility {
             result = fmt::format("{} - cost: {}", label, durationStr);
         }
 
+        template <typename Out>
+        static Out formatDurationTo(Out out, std::chrono::duration<double, std::milli> const &duration) {
+            auto formattedDuration = utility::time::break_down_durations<std::chrono::hours,
+                                                                         std::chrono::minutes,
+                                                                         std::chrono::seconds,
+                                                                         std::chrono::milliseconds,
+                                                                         std::chrono::microseconds>(duration);
+            return fmt::format_to(out, "{}h, {}min, {}sec, {}ms, {}us",
+                                  std::get<0>(formattedDuration).count(),
+                                  std::get<1>(formattedDuration).count(),
+                                  std::get<2>(formattedDuration).count(),
+                                  std::get<3>(formattedDuration).count(),
+                                  std::get<4>(formattedDuration).count());
+        }
+
+        void measure(std::string_view label, std::pmr::string &result, std::function<void()> const &lambda) {
+
+            std::chrono::time_point<std::chrono::high_resolution_clock> start;
+            std::chrono::time_point<std::chrono::high_resolution_clock> end;
+
+            measure(start, end, lambda);
+
+            std::chrono::duration<double, std::milli> elapsed = end - start;
+
+            result.clear();
+            fmt::format_to(std::back_inserter(result), "{} - cost: ", label);
+            formatDurationTo(std::back_inserter(result), elapsed);
+        }
+
         void measure(std::chrono::time_point<std::chrono::high_resolution_clock> &start,
                      std::chrono::time_point<std::chrono::high_resolution_clock> &end,
                      std::function<void()> const &lambda) {
@@ -96,17 +258,9 @@ namespace utility {
         }
 
         std::string formatToString(std::chrono::duration<double, std::milli> const &duration) {
-            auto formattedDuration = utility::time::break_down_durations<std::chrono::hours,
-                                                                         std::chrono::minutes,
-                                                                         std::chrono::seconds,
-                                                                         std::chrono::milliseconds,
-                                                                         std::chrono::microseconds>(duration);
-            return fmt::format("{}h, {}min, {}sec, {}ms, {}us",
-                               std::get<0>(formattedDuration).count(),
-                               std::get<1>(formattedDuration).count(),
-                               std::get<2>(formattedDuration).count(),
-                               std::get<3>(formattedDuration).count(),
-                               std::get<4>(formattedDuration).count());
+            std::string result;
+            formatDurationTo(std::back_inserter(result), duration);
+            return result;
         }
 
         Timer::Timer(const std::string &label) {
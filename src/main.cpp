@@ -1,4 +1,5 @@
 #include "AppConfig.h"
+#include "Bench/Bench.h"
 #include "SnakeApp.h"
 #include "TrainApp.h"
 #include <fmt/core.h>
@@ -42,6 +43,13 @@ static bool ValidateMode(const char *flagname, int64_t value) {
 DEFINE_int64(mode, 0, "running mode should be one of '0/1/2', 0 is default");
 DEFINE_validator(mode, &ValidateMode);
 
+/* training thread pool */
+DEFINE_int32(threads, -1, "training worker threads, 0 = effective cpus of this process, -1 = use appConfig.json");
+DEFINE_string(affinity, "", "pin training workers to cpus: none/compact/scatter, empty = use appConfig.json");
+
+/* benchmarks, run with the training rules */
+DEFINE_string(bench, "", "run a benchmark instead of the app: alloc/body/boards/dims/engine/lanes/replay/seeds/vecenv/vision");
+
 void initFlags(int argc, char *argv[]) {
     gflags::SetVersionString(g_version);
     gflags::SetUsageMessage(g_help);
@@ -88,8 +96,16 @@ int main(int argc, char *argv[]) {
     initFlags(argc, argv);
     initLogger(argv);
 
-    AppConfig::Get().setAppRunMode(AppRunMode(FLAGS_mode));
+    AppConfig::Get().setAppRunMode(FLAGS_bench.empty() ? AppRunMode(FLAGS_mode) : AppRunMode(AppRunMode::train));
     AppConfig::Get().initAppConfig();
+    AppConfig::Get().setThreadNumOverride(FLAGS_threads);
+    AppConfig::Get().setThreadAffinityOverride(FLAGS_affinity);
+
+    if (!FLAGS_bench.empty()) {
+        result = bench::run(FLAGS_bench);
+        deinitLogger();
+        return result;
+    }
 
     auto mode = AppConfig::RunMode();
     LOG(INFO) << "App run mode = " << mode.description();